@@ -0,0 +1,92 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+
+#include "matrix.hpp"
+template <typename Type>
+struct MatrixShape;
+template <size_t N, size_t M, typename T>
+struct MatrixShape<Matrix<N, M, T>> {
+  static constexpr size_t kRows = N;
+  static constexpr size_t kCols = M;
+  using Element = T;
+};
+template <size_t K>
+struct MatrixChain {
+  std::array<std::array<size_t, K>, K> cost{};
+  std::array<std::array<size_t, K>, K> split{};
+};
+template <size_t K>
+constexpr MatrixChain<K> SolveMatrixChain(
+    const std::array<size_t, K + 1>& dims) {
+  MatrixChain<K> chain;
+  for (size_t length = 1; length < K; ++length) {
+    for (size_t first = 0; first + length < K; ++first) {
+      size_t last = first + length;
+      chain.cost[first][last] = SIZE_MAX;
+      for (size_t middle = first; middle < last; ++middle) {
+        size_t cost = chain.cost[first][middle] +
+                      chain.cost[middle + 1][last] +
+                      dims[first] * dims[middle + 1] * dims[last + 1];
+        if (cost < chain.cost[first][last]) {
+          chain.cost[first][last] = cost;
+          chain.split[first][last] = middle;
+        }
+      }
+    }
+  }
+  return chain;
+}
+template <size_t K>
+constexpr bool IsMatrixChain(const std::array<size_t, K + 1>& dims,
+                             const std::array<size_t, K>& cols) {
+  for (size_t index = 0; index < K; ++index) {
+    if (cols[index] != dims[index + 1]) {
+      return false;
+    }
+  }
+  return true;
+}
+template <typename... Matrices>
+class MatrixProduct {
+ public:
+  static constexpr size_t kCount = sizeof...(Matrices);
+  static_assert(kCount > 0, "Product needs at least one matrix");
+  using First = std::tuple_element_t<0, std::tuple<Matrices...>>;
+  using Last = std::tuple_element_t<kCount - 1, std::tuple<Matrices...>>;
+  using Element = typename MatrixShape<First>::Element;
+  static_assert(
+      (std::is_same_v<typename MatrixShape<Matrices>::Element, Element> &&
+       ...),
+      "Product needs matrices of one element type");
+  using Result =
+      Matrix<MatrixShape<First>::kRows, MatrixShape<Last>::kCols, Element>;
+  static constexpr std::array<size_t, kCount + 1> kDims = {
+      MatrixShape<Matrices>::kRows..., MatrixShape<Last>::kCols};
+  static constexpr std::array<size_t, kCount> kCols = {
+      MatrixShape<Matrices>::kCols...};
+  static_assert(IsMatrixChain<kCount>(kDims, kCols),
+                "Product needs matching inner dimensions");
+  static constexpr MatrixChain<kCount> kChain =
+      SolveMatrixChain<kCount>(kDims);
+  static constexpr size_t kCost = kChain.cost[0][kCount - 1];
+  template <size_t From, size_t To>
+  static decltype(auto) Evaluate(
+      const std::tuple<const Matrices&...>& matrices) {
+    if constexpr (From == To) {
+      return std::get<From>(matrices);
+    } else {
+      constexpr size_t kSplit = kChain.split[From][To];
+      return Evaluate<From, kSplit>(matrices) *
+             Evaluate<kSplit + 1, To>(matrices);
+    }
+  }
+};
+template <typename... Matrices>
+typename MatrixProduct<Matrices...>::Result Product(
+    const Matrices&... matrices) {
+  return MatrixProduct<Matrices...>::template Evaluate<
+      0, sizeof...(Matrices) - 1>(std::tie(matrices...));
+}
@@ -0,0 +1,98 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+template <size_t N, size_t M, typename T>
+class Matrix;
+template <typename Derived, size_t N, size_t M, typename T>
+class MatrixExpression {
+ public:
+  static constexpr size_t kRows = N;
+  static constexpr size_t kCols = M;
+  using Element = T;
+  const Derived& Self() const { return static_cast<const Derived&>(*this); }
+  T operator()(size_t i, size_t ind) const {
+    return Self().Element(i * M + ind);
+  }
+  Matrix<M, N, T> Transposed() const;
+  T Trace() const;
+};
+template <typename Operand>
+using MatrixTerm = std::remove_cvref_t<Operand>;
+template <typename Operand>
+concept MatrixExpressionOperand = std::is_base_of_v<
+    MatrixExpression<MatrixTerm<Operand>, MatrixTerm<Operand>::kRows,
+                     MatrixTerm<Operand>::kCols,
+                     typename MatrixTerm<Operand>::Element>,
+    MatrixTerm<Operand>>;
+template <typename Lhs, typename Rhs>
+concept MatrixSameShape =
+    MatrixExpressionOperand<Lhs> && MatrixExpressionOperand<Rhs> &&
+    MatrixTerm<Lhs>::kRows == MatrixTerm<Rhs>::kRows &&
+    MatrixTerm<Lhs>::kCols == MatrixTerm<Rhs>::kCols &&
+    std::is_same_v<typename MatrixTerm<Lhs>::Element,
+                   typename MatrixTerm<Rhs>::Element>;
+template <typename Operand>
+using MatrixOperand =
+    std::conditional_t<std::is_lvalue_reference_v<Operand> &&
+                           MatrixTerm<Operand>::kLeaf,
+                       const MatrixTerm<Operand>&, MatrixTerm<Operand>>;
+template <typename Lhs, typename Rhs, typename Operation, size_t N, size_t M,
+          typename T>
+class MatrixBinary
+    : public MatrixExpression<MatrixBinary<Lhs, Rhs, Operation, N, M, T>, N,
+                              M, T> {
+ public:
+  static constexpr bool kLeaf = false;
+  template <typename LhsArg, typename RhsArg>
+  MatrixBinary(LhsArg&& lhs, RhsArg&& rhs)
+      : lhs_(std::forward<LhsArg>(lhs)), rhs_(std::forward<RhsArg>(rhs)) {}
+  T Element(size_t index) const {
+    return Operation()(lhs_.Element(index), rhs_.Element(index));
+  }
+
+ private:
+  Lhs lhs_;
+  Rhs rhs_;
+};
+template <typename Operand, size_t N, size_t M, typename T>
+class MatrixScaled
+    : public MatrixExpression<MatrixScaled<Operand, N, M, T>, N, M, T> {
+ public:
+  static constexpr bool kLeaf = false;
+  template <typename OperandArg>
+  MatrixScaled(OperandArg&& operand, const T& multiplier)
+      : operand_(std::forward<OperandArg>(operand)), multiplier_(multiplier) {}
+  T Element(size_t index) const {
+    return operand_.Element(index) * multiplier_;
+  }
+
+ private:
+  Operand operand_;
+  T multiplier_;
+};
+template <typename Lhs, typename Rhs, template <typename> class Operation>
+using MatrixBinaryOf =
+    MatrixBinary<MatrixOperand<Lhs>, MatrixOperand<Rhs>,
+                 Operation<typename MatrixTerm<Lhs>::Element>,
+                 MatrixTerm<Lhs>::kRows, MatrixTerm<Lhs>::kCols,
+                 typename MatrixTerm<Lhs>::Element>;
+template <typename Lhs, typename Rhs>
+  requires MatrixSameShape<Lhs, Rhs>
+MatrixBinaryOf<Lhs, Rhs, std::plus> operator+(Lhs&& lhs, Rhs&& rhs) {
+  return {std::forward<Lhs>(lhs), std::forward<Rhs>(rhs)};
+}
+template <typename Lhs, typename Rhs>
+  requires MatrixSameShape<Lhs, Rhs>
+MatrixBinaryOf<Lhs, Rhs, std::minus> operator-(Lhs&& lhs, Rhs&& rhs) {
+  return {std::forward<Lhs>(lhs), std::forward<Rhs>(rhs)};
+}
+template <typename Operand>
+  requires MatrixExpressionOperand<Operand>
+MatrixScaled<MatrixOperand<Operand>, MatrixTerm<Operand>::kRows,
+             MatrixTerm<Operand>::kCols, typename MatrixTerm<Operand>::Element>
+operator*(Operand&& operand,
+          const typename MatrixTerm<Operand>::Element& multiplier) {
+  return {std::forward<Operand>(operand), multiplier};
+}
@@ -0,0 +1,143 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+template <typename T>
+inline constexpr bool kGemmSupported = std::is_same_v<T, float> ||
+                                       std::is_same_v<T, double> ||
+                                       std::is_same_v<T, int64_t>;
+template <typename T>
+class GemmKernel {
+ public:
+#if defined(__AVX2__) || defined(__AVX__)
+  static constexpr size_t kVectorBytes = 32;
+  static constexpr size_t kTileRows = 6;
+#else
+  static constexpr size_t kVectorBytes = 16;
+  static constexpr size_t kTileRows = 4;
+#endif
+  static constexpr size_t kLanes = kVectorBytes / sizeof(T);
+  static constexpr size_t kTileCols = 2 * kLanes;
+  static constexpr size_t kDepthBlock = 256;
+  static constexpr size_t kRowBlock = 16 * kTileRows;
+  static constexpr size_t kColBlock = 1024;
+  static void Multiply(const T* lhs, const T* rhs, T* result, size_t rows,
+                       size_t depth, size_t cols);
+  static void MultiplyRows(const T* lhs, const T* rhs, T* result,
+                           size_t first_row, size_t last_row, size_t depth,
+                           size_t cols);
+
+ private:
+  typedef T Vector __attribute__((vector_size(kVectorBytes)));
+  static void PackLhs(const T* lhs, size_t stride, size_t rows, size_t depth,
+                      T* packed);
+  static void PackRhs(const T* rhs, size_t stride, size_t depth, size_t cols,
+                      T* packed);
+  static void MicroKernel(size_t depth, const T* lhs, const T* rhs, T* result,
+                          size_t stride, size_t rows, size_t cols);
+};
+template <typename T>
+void GemmKernel<T>::Multiply(const T* lhs, const T* rhs, T* result,
+                             size_t rows, size_t depth, size_t cols) {
+  MultiplyRows(lhs, rhs, result, 0, rows, depth, cols);
+}
+template <typename T>
+void GemmKernel<T>::MultiplyRows(const T* lhs, const T* rhs, T* result,
+                                 size_t first_row, size_t last_row,
+                                 size_t depth, size_t cols) {
+  std::fill(result + first_row * cols, result + last_row * cols, T());
+  std::vector<T> packed_lhs(kRowBlock * kDepthBlock);
+  std::vector<T> packed_rhs(kDepthBlock * (kColBlock + kTileCols));
+  for (size_t col = 0; col < cols; col += kColBlock) {
+    size_t col_count = std::min(kColBlock, cols - col);
+    for (size_t inner = 0; inner < depth; inner += kDepthBlock) {
+      size_t inner_count = std::min(kDepthBlock, depth - inner);
+      PackRhs(rhs + inner * cols + col, cols, inner_count, col_count,
+              packed_rhs.data());
+      for (size_t row = first_row; row < last_row; row += kRowBlock) {
+        size_t row_count = std::min(kRowBlock, last_row - row);
+        PackLhs(lhs + row * depth + inner, depth, row_count, inner_count,
+                packed_lhs.data());
+        for (size_t tile_col = 0; tile_col < col_count;
+             tile_col += kTileCols) {
+          for (size_t tile_row = 0; tile_row < row_count;
+               tile_row += kTileRows) {
+            MicroKernel(inner_count, packed_lhs.data() + tile_row * inner_count,
+                        packed_rhs.data() + tile_col * inner_count,
+                        result + (row + tile_row) * cols + col + tile_col,
+                        cols, std::min(kTileRows, row_count - tile_row),
+                        std::min(kTileCols, col_count - tile_col));
+          }
+        }
+      }
+    }
+  }
+}
+template <typename T>
+void GemmKernel<T>::PackLhs(const T* lhs, size_t stride, size_t rows,
+                            size_t depth, T* packed) {
+  for (size_t row = 0; row < rows; row += kTileRows) {
+    for (size_t index = 0; index < depth; ++index) {
+      for (size_t offset = 0; offset < kTileRows; ++offset) {
+        *packed++ = row + offset < rows
+                        ? lhs[(row + offset) * stride + index]
+                        : T();
+      }
+    }
+  }
+}
+template <typename T>
+void GemmKernel<T>::PackRhs(const T* rhs, size_t stride, size_t depth,
+                            size_t cols, T* packed) {
+  for (size_t col = 0; col < cols; col += kTileCols) {
+    size_t count = std::min(kTileCols, cols - col);
+    for (size_t index = 0; index < depth; ++index) {
+      std::copy(rhs + index * stride + col,
+                rhs + index * stride + col + count, packed);
+      std::fill(packed + count, packed + kTileCols, T());
+      packed += kTileCols;
+    }
+  }
+}
+template <typename T>
+void GemmKernel<T>::MicroKernel(size_t depth, const T* lhs, const T* rhs,
+                                T* result, size_t stride, size_t rows,
+                                size_t cols) {
+  Vector sums[kTileRows][2] = {};
+  for (size_t index = 0; index < depth; ++index) {
+    Vector low;
+    Vector high;
+    memcpy(&low, rhs, kVectorBytes);
+    memcpy(&high, rhs + kLanes, kVectorBytes);
+#pragma GCC unroll 8
+    for (size_t row = 0; row < kTileRows; ++row) {
+      Vector broadcast = Vector{} + lhs[row];
+      sums[row][0] += broadcast * low;
+      sums[row][1] += broadcast * high;
+    }
+    lhs += kTileRows;
+    rhs += kTileCols;
+  }
+  if (rows == kTileRows && cols == kTileCols) {
+    for (size_t row = 0; row < kTileRows; ++row) {
+      Vector low;
+      Vector high;
+      memcpy(&low, result + row * stride, kVectorBytes);
+      memcpy(&high, result + row * stride + kLanes, kVectorBytes);
+      low += sums[row][0];
+      high += sums[row][1];
+      memcpy(result + row * stride, &low, kVectorBytes);
+      memcpy(result + row * stride + kLanes, &high, kVectorBytes);
+    }
+    return;
+  }
+  T tile[kTileRows][kTileCols];
+  memcpy(tile, sums, sizeof(tile));
+  for (size_t row = 0; row < rows; ++row) {
+    for (size_t col = 0; col < cols; ++col) {
+      result[row * stride + col] += tile[row][col];
+    }
+  }
+}
@@ -1,128 +1,228 @@
+#pragma once
 #include <assert.h>
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <iostream>
+#include <new>
+#include <utility>
 #include <vector>
+
+#include "expression.hpp"
+#include "gemm.hpp"
+#include "parallel.hpp"
+const size_t kMatrixAlignment = 64;
+const size_t kMatrixInlineBytes = 512;
+const size_t kMatrixGemmThreshold = 32 * 32 * 32;
+struct MatrixUninitialized {};
+template <typename T>
+class AlignedAllocator {
+ public:
+  using value_type = T;
+  AlignedAllocator() = default;
+  template <typename U>
+  AlignedAllocator(const AlignedAllocator<U>&) {}
+  T* allocate(size_t count) {
+    return static_cast<T*>(::operator new(
+        count * sizeof(T), std::align_val_t(kMatrixAlignment)));
+  }
+  void deallocate(T* ptr, size_t) {
+    ::operator delete(ptr, std::align_val_t(kMatrixAlignment));
+  }
+  template <typename U>
+  void construct(U* ptr) {
+    ::new (static_cast<void*>(ptr)) U;
+  }
+  template <typename U, typename... Args>
+  void construct(U* ptr, Args&&... args) {
+    ::new (static_cast<void*>(ptr)) U(std::forward<Args>(args)...);
+  }
+  template <typename U>
+  bool operator==(const AlignedAllocator<U>&) const {
+    return true;
+  }
+};
+template <typename T, size_t Size,
+          bool Inline = Size * sizeof(T) <= kMatrixInlineBytes>
+class MatrixStorage {
+ public:
+  MatrixStorage() : data_() {}
+  explicit MatrixStorage(MatrixUninitialized) {}
+  explicit MatrixStorage(const T& elem) { data_.fill(elem); }
+  T* Data() { return data_.data(); }
+  const T* Data() const { return data_.data(); }
+
+ private:
+  alignas(kMatrixAlignment) std::array<T, Size> data_;
+};
+template <typename T, size_t Size>
+class MatrixStorage<T, Size, false> {
+ public:
+  MatrixStorage() : data_(Size, T()) {}
+  explicit MatrixStorage(MatrixUninitialized) : data_(Size) {}
+  explicit MatrixStorage(const T& elem) : data_(Size, elem) {}
+  T* Data() { return data_.data(); }
+  const T* Data() const { return data_.data(); }
+
+ private:
+  std::vector<T, AlignedAllocator<T>> data_;
+};
 template <size_t N, size_t M, typename T = int64_t>
-class Matrix {
+class Matrix : public MatrixExpression<Matrix<N, M, T>, N, M, T> {
  public:
-  Matrix();
+  static constexpr bool kLeaf = true;
+  Matrix() = default;
   Matrix(const T& elem);
   Matrix(std::vector<std::vector<T>>& old_vector);
-  Matrix<N, M, T>& operator+=(const Matrix<N, M, T>& other);
-  Matrix<N, M, T>& operator-=(Matrix<N, M, T>& other);
-  Matrix<N, M, T> operator+(const Matrix<N, M, T>& other);
-  Matrix<N, M, T> operator-(Matrix<N, M, T>& other);
-  Matrix<N, M, T> operator*(const T& multiplier);
-  template <size_t P>
-  Matrix<N, P, T> operator*(const Matrix<M, P, T>& other);
-  Matrix<M, N, T> Transposed();
-  T Trace();
+  template <typename Expression>
+  Matrix(const MatrixExpression<Expression, N, M, T>& expression);
+  template <typename Expression>
+  Matrix<N, M, T>& operator=(
+      const MatrixExpression<Expression, N, M, T>& expression);
+  template <typename Expression>
+  Matrix<N, M, T>& operator+=(
+      const MatrixExpression<Expression, N, M, T>& other);
+  template <typename Expression>
+  Matrix<N, M, T>& operator-=(
+      const MatrixExpression<Expression, N, M, T>& other);
+  Matrix<M, N, T> Transposed() const;
+  T Trace() const;
   const T& operator()(size_t i, size_t ind) const;
   T& operator()(size_t i, size_t ind);
-  bool operator==(Matrix<N, M, T>& other);
+  const T& Element(size_t index) const { return Data()[index]; }
+  bool operator==(const Matrix<N, M, T>& other) const;
+  T* Data() { return data_.Data(); }
+  const T* Data() const { return data_.Data(); }
 
  private:
-  std::vector<std::vector<T>> data_;
+  template <typename Expression, typename Operation>
+  void Evaluate(const MatrixExpression<Expression, N, M, T>& expression,
+                Operation operation);
+  MatrixStorage<T, N * M> data_;
 };
 template <size_t N, size_t M, typename T>
-Matrix<N, M, T>::Matrix()
-    : data_(std::vector<std::vector<T>>(N, std::vector<T>(M))) {}
-template <size_t N, size_t M, typename T>
-Matrix<N, M, T>::Matrix(const T& elem)
-    : data_(std::vector<std::vector<T>>(N, std::vector<T>(M, elem))) {}
-template <size_t N, size_t M, typename T>
-Matrix<N, M, T>::Matrix(std::vector<std::vector<T>>& old_vector)
-    : data_(old_vector) {}
+Matrix<N, M, T>::Matrix(const T& elem) : data_(elem) {}
 template <size_t N, size_t M, typename T>
-Matrix<N, M, T>& Matrix<N, M, T>::operator+=(const Matrix<N, M, T>& other) {
+Matrix<N, M, T>::Matrix(std::vector<std::vector<T>>& old_vector) {
   for (size_t i = 0; i < N; ++i) {
-    for (size_t ind = 0; ind < M; ++ind) {
-      data_[i][ind] += other(i, ind);
-    }
+    std::copy(old_vector[i].begin(), old_vector[i].begin() + M,
+              Data() + i * M);
   }
-  return *this;
 }
 template <size_t N, size_t M, typename T>
-Matrix<N, M, T>& Matrix<N, M, T>::operator-=(Matrix<N, M, T>& other) {
-  for (size_t i = 0; i < N; ++i) {
-    for (size_t ind = 0; ind < M; ++ind) {
-      data_[i][ind] -= other(i, ind);
-    }
-  }
+template <typename Expression>
+Matrix<N, M, T>::Matrix(const MatrixExpression<Expression, N, M, T>& expression)
+    : data_(MatrixUninitialized()) {
+  Evaluate(expression, [](T& element, T value) { element = value; });
+}
+template <size_t N, size_t M, typename T>
+template <typename Expression>
+Matrix<N, M, T>& Matrix<N, M, T>::operator=(
+    const MatrixExpression<Expression, N, M, T>& expression) {
+  Evaluate(expression, [](T& element, T value) { element = value; });
   return *this;
 }
 template <size_t N, size_t M, typename T>
-Matrix<N, M, T> Matrix<N, M, T>::operator+(const Matrix<N, M, T>& other) {
-  Matrix<N, M, T> newmatrix(*this);
-  newmatrix += other;
-  return newmatrix;
+template <typename Expression>
+Matrix<N, M, T>& Matrix<N, M, T>::operator+=(
+    const MatrixExpression<Expression, N, M, T>& other) {
+  Evaluate(other, [](T& element, T value) { element += value; });
+  return *this;
 }
 template <size_t N, size_t M, typename T>
-Matrix<N, M, T> Matrix<N, M, T>::operator-(Matrix<N, M, T>& other) {
-  Matrix<N, M, T> newmatrix(*this);
-  newmatrix -= other;
-  return newmatrix;
+template <typename Expression>
+Matrix<N, M, T>& Matrix<N, M, T>::operator-=(
+    const MatrixExpression<Expression, N, M, T>& other) {
+  Evaluate(other, [](T& element, T value) { element -= value; });
+  return *this;
 }
 template <size_t N, size_t M, typename T>
-Matrix<N, M, T> Matrix<N, M, T>::operator*(const T& multiplier) {
-  Matrix<N, M, T> newmatrix;
-  for (size_t i = 0; i < N; ++i) {
-    for (size_t ind = 0; ind < M; ++ind) {
-      newmatrix(i, ind) = data_[i][ind] * multiplier;
+template <typename Expression, typename Operation>
+void Matrix<N, M, T>::Evaluate(
+    const MatrixExpression<Expression, N, M, T>& expression,
+    Operation operation) {
+  T* data = Data();
+  const Expression& source = expression.Self();
+  MatrixParallel::For(N * M, N * M, [&](size_t first, size_t last) {
+    for (size_t i = first; i < last; ++i) {
+      operation(data[i], source.Element(i));
     }
+  });
+}
+template <typename Derived, size_t N, size_t M, typename T>
+Matrix<M, N, T> MatrixExpression<Derived, N, M, T>::Transposed() const {
+  return Matrix<N, M, T>(*this).Transposed();
+}
+template <typename Derived, size_t N, size_t M, typename T>
+T MatrixExpression<Derived, N, M, T>::Trace() const {
+  static_assert(N == M);
+  return Matrix<N, M, T>(*this).Trace();
+}
+template <typename Expression, size_t N, size_t M, typename T>
+decltype(auto) Materialize(
+    const MatrixExpression<Expression, N, M, T>& expression) {
+  if constexpr (Expression::kLeaf) {
+    return expression.Self();
+  } else {
+    return Matrix<N, M, T>(expression);
   }
-  return newmatrix;
 }
-template <size_t N, size_t M, typename T>
-template <size_t P>
-Matrix<N, P, T> Matrix<N, M, T>::operator*(const Matrix<M, P, T>& other) {
+template <typename Lhs, typename Rhs, size_t N, size_t M, size_t P,
+          typename T>
+Matrix<N, P, T> operator*(const MatrixExpression<Lhs, N, M, T>& lhs,
+                          const MatrixExpression<Rhs, M, P, T>& rhs) {
+  const Matrix<N, M, T>& left = Materialize(lhs);
+  const Matrix<M, P, T>& right = Materialize(rhs);
   Matrix<N, P, T> newmatrix;
-  for (size_t i = 0; i < N; ++i) {
-    for (size_t ind = 0; ind < P; ++ind) {
-      T sum = 0.0;
-      for (size_t z = 0; z < M; ++z) {
-        sum += (data_[i][z] * other(z, ind));
+  if constexpr (kGemmSupported<T> && N * M * P >= kMatrixGemmThreshold) {
+    MatrixParallel::For(N, N * M * P, [&](size_t first, size_t last) {
+      GemmKernel<T>::MultiplyRows(left.Data(), right.Data(),
+                                  newmatrix.Data(), first, last, M, P);
+    });
+  } else {
+    MatrixParallel::For(N, N * M * P, [&](size_t first, size_t last) {
+      for (size_t i = first; i < last; ++i) {
+        for (size_t ind = 0; ind < P; ++ind) {
+          T sum = 0.0;
+          for (size_t z = 0; z < M; ++z) {
+            sum += (left(i, z) * right(z, ind));
+          }
+          newmatrix(i, ind) = sum;
+        }
       }
-      newmatrix(i, ind) = sum;
-    }
+    });
   }
   return newmatrix;
 }
 template <size_t N, size_t M, typename T>
-Matrix<M, N, T> Matrix<N, M, T>::Transposed() {
+Matrix<M, N, T> Matrix<N, M, T>::Transposed() const {
   Matrix<M, N, T> newmatrix;
   for (size_t i = 0; i < N; ++i) {
     for (size_t ind = 0; ind < M; ++ind) {
-      newmatrix(ind, i) = data_[i][ind];
+      newmatrix(ind, i) = (*this)(i, ind);
     }
   }
   return newmatrix;
 }
 template <size_t N, size_t M, typename T>
-T Matrix<N, M, T>::Trace() {
+T Matrix<N, M, T>::Trace() const {
   static_assert(N == M);
-  T sum = data_[0][0];
+  T sum = (*this)(0, 0);
   for (size_t i = 1; i < N; ++i) {
-    sum += data_[i][i];
+    sum += (*this)(i, i);
   }
   return sum;
 }
 template <size_t N, size_t M, typename T>
 const T& Matrix<N, M, T>::operator()(size_t i, size_t ind) const {
-  return data_[i][ind];
+  return Data()[i * M + ind];
 }
 template <size_t N, size_t M, typename T>
 T& Matrix<N, M, T>::operator()(size_t i, size_t ind) {
-  return data_[i][ind];
+  return Data()[i * M + ind];
 }
 template <size_t N, size_t M, typename T>
-bool Matrix<N, M, T>::operator==(Matrix<N, M, T>& other) {
-  for (size_t i = 0; i < N; ++i) {
-    for (size_t ind = 0; ind < M; ++ind) {
-      if (data_[i][ind] != other(i, ind)) {
-        return false;
-      }
-    }
-  }
-  return true;
-}
\ No newline at end of file
+bool Matrix<N, M, T>::operator==(const Matrix<N, M, T>& other) const {
+  return std::equal(Data(), Data() + N * M, other.Data());
+}
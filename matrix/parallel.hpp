@@ -0,0 +1,60 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+class MatrixParallel {
+ public:
+  static constexpr size_t kDefaultThreshold = 1 << 20;
+  static unsigned int Threads() {
+    unsigned int threads = threads_.load(std::memory_order_relaxed);
+    return threads != 0 ? threads
+                        : std::max(1u, std::thread::hardware_concurrency());
+  }
+  static void SetThreads(unsigned int threads) {
+    threads_.store(threads, std::memory_order_relaxed);
+  }
+  static size_t Threshold() {
+    return threshold_.load(std::memory_order_relaxed);
+  }
+  static void SetThreshold(size_t threshold) {
+    threshold_.store(threshold, std::memory_order_relaxed);
+  }
+  template <typename Function>
+  static void For(size_t count, size_t cost, Function function);
+
+ private:
+  static inline std::atomic<unsigned int> threads_{0};
+  static inline std::atomic<size_t> threshold_{kDefaultThreshold};
+};
+template <typename Function>
+void MatrixParallel::For(size_t count, size_t cost, Function function) {
+  size_t tasks = cost < Threshold() ? 1 : std::min<size_t>(Threads(), count);
+  if (tasks <= 1) {
+    function(size_t(0), count);
+    return;
+  }
+  std::vector<std::exception_ptr> errors(tasks);
+  auto run = [&](size_t task) {
+    try {
+      function(count * task / tasks, count * (task + 1) / tasks);
+    } catch (...) {
+      errors[task] = std::current_exception();
+    }
+  };
+  std::vector<std::thread> workers;
+  workers.reserve(tasks - 1);
+  for (size_t task = 1; task < tasks; ++task) {
+    workers.emplace_back(run, task);
+  }
+  run(0);
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+  for (const std::exception_ptr& error : errors) {
+    if (error != nullptr) {
+      std::rethrow_exception(error);
+    }
+  }
+}
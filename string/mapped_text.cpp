@@ -0,0 +1,124 @@
+#include "mapped_text.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <bit>
+#include <cerrno>
+#include <stdexcept>
+#include <system_error>
+#if defined(__SSE2__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+namespace {
+void PushMatches(std::vector<size_t>& positions, size_t offset,
+                 unsigned int mask) {
+  for (; mask != 0; mask &= mask - 1) {
+    positions.push_back(offset + std::countr_zero(mask) + 1);
+  }
+}
+void CollectLineStarts(const char* str, size_t size,
+                       std::vector<size_t>& starts) {
+  size_t index = 0;
+#if defined(__AVX2__)
+  const __m256i newline32 = _mm256_set1_epi8('\n');
+  for (; size - index >= 32; index += 32) {
+    __m256i block =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str + index));
+    PushMatches(starts, index,
+                _mm256_movemask_epi8(_mm256_cmpeq_epi8(block, newline32)));
+  }
+#endif
+#if defined(__SSE2__)
+  const __m128i newline16 = _mm_set1_epi8('\n');
+  for (; size - index >= 16; index += 16) {
+    __m128i block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + index));
+    PushMatches(starts, index,
+                _mm_movemask_epi8(_mm_cmpeq_epi8(block, newline16)));
+  }
+#endif
+  for (; index < size; ++index) {
+    if (str[index] == '\n') {
+      starts.push_back(index + 1);
+    }
+  }
+}
+}  // namespace
+MappedText::MappedText(const char* path, bool index_lines) {
+  int fd = open(path, O_RDONLY | O_CLOEXEC);
+  if (fd == -1) {
+    throw std::system_error(errno, std::generic_category(), path);
+  }
+  struct stat info;
+  if (fstat(fd, &info) == -1) {
+    int error = errno;
+    close(fd);
+    throw std::system_error(error, std::generic_category(), path);
+  }
+  if (info.st_size > 0) {
+    mapping_ = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping_ == MAP_FAILED) {
+      int error = errno;
+      mapping_ = nullptr;
+      close(fd);
+      throw std::system_error(error, std::generic_category(), path);
+    }
+    data_ = static_cast<const char*>(mapping_);
+    size_ = info.st_size;
+  }
+  close(fd);
+  if (index_lines) {
+    BuildLineIndex();
+  }
+}
+MappedText::MappedText(MappedText&& other) noexcept { Swap(other); }
+MappedText& MappedText::operator=(MappedText&& other) noexcept {
+  MappedText newtext(std::move(other));
+  Swap(newtext);
+  return *this;
+}
+MappedText::~MappedText() { Unmap(); }
+void MappedText::BuildLineIndex() {
+  if (HasLineIndex()) {
+    return;
+  }
+  std::vector<size_t> starts;
+  starts.reserve(size_ / 64 + 2);
+  starts.push_back(0);
+  CollectLineStarts(data_, size_, starts);
+  if (starts.back() != size_) {
+    starts.push_back(size_ + 1);
+  }
+  line_starts_.swap(starts);
+}
+size_t MappedText::LineCount() const {
+  if (!HasLineIndex()) {
+    throw std::logic_error("MappedText: line index is not built");
+  }
+  return line_starts_.size() - 1;
+}
+StringView MappedText::Line(size_t index) const {
+  if (index >= LineCount()) {
+    throw std::out_of_range("MappedText: line index out of range");
+  }
+  return StringView(data_ + line_starts_[index],
+                    line_starts_[index + 1] - line_starts_[index] - 1);
+}
+void MappedText::Swap(MappedText& other) noexcept {
+  std::swap(data_, other.data_);
+  std::swap(size_, other.size_);
+  std::swap(mapping_, other.mapping_);
+  line_starts_.swap(other.line_starts_);
+}
+void MappedText::Unmap() {
+  if (mapping_ != nullptr) {
+    munmap(mapping_, size_);
+  }
+  mapping_ = nullptr;
+  data_ = "";
+  size_ = 0;
+  line_starts_.clear();
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <vector>
+
+#include "string.hpp"
+class MappedText {
+ public:
+  MappedText() = default;
+  explicit MappedText(const char* path, bool index_lines = false);
+  MappedText(const MappedText& other) = delete;
+  MappedText(MappedText&& other) noexcept;
+  MappedText& operator=(const MappedText& other) = delete;
+  MappedText& operator=(MappedText&& other) noexcept;
+  ~MappedText();
+  const char* Data() const { return data_; }
+  size_t Size() const { return size_; }
+  bool Empty() const { return size_ == 0; }
+  StringView View() const { return StringView(data_, size_); }
+  operator StringView() const { return View(); }
+  void BuildLineIndex();
+  bool HasLineIndex() const { return !line_starts_.empty(); }
+  size_t LineCount() const;
+  StringView Line(size_t index) const;
+  void Swap(MappedText& other) noexcept;
+
+ private:
+  void Unmap();
+  const char* data_ = "";
+  size_t size_ = 0;
+  void* mapping_ = nullptr;
+  std::vector<size_t> line_starts_;
+};
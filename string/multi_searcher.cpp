@@ -0,0 +1,121 @@
+#include "multi_searcher.hpp"
+MultiSearcher::MultiSearcher(const std::vector<StringView>& patterns) {
+  Build(patterns);
+}
+MultiSearcher::MultiSearcher(const std::vector<String>& patterns) {
+  Build(std::vector<StringView>(patterns.begin(), patterns.end()));
+}
+void MultiSearcher::Build(const std::vector<StringView>& patterns) {
+  for (StringView pattern : patterns) {
+    for (size_t index = 0; index < pattern.Size(); ++index) {
+      uint16_t& byte_class = class_[static_cast<unsigned char>(pattern[index])];
+      if (byte_class == 0) {
+        byte_class = classes_++;
+      }
+    }
+  }
+  delta_.assign(classes_, 0);
+  terminal_.assign(1, kNone);
+  next_pattern_.assign(patterns.size(), kNone);
+  lengths_.reserve(patterns.size());
+  for (size_t id = 0; id < patterns.size(); ++id) {
+    StringView pattern = patterns[id];
+    lengths_.push_back(pattern.Size());
+    if (pattern.Empty()) {
+      continue;
+    }
+    uint32_t state = 0;
+    for (size_t index = 0; index < pattern.Size(); ++index) {
+      size_t edge = state * classes_ +
+                    class_[static_cast<unsigned char>(pattern[index])];
+      if (delta_[edge] == 0) {
+        delta_[edge] = terminal_.size();
+        terminal_.push_back(kNone);
+        delta_.resize(delta_.size() + classes_, 0);
+      }
+      state = delta_[edge];
+    }
+    next_pattern_[id] = terminal_[state];
+    terminal_[state] = id;
+  }
+  std::vector<uint32_t> fail(terminal_.size(), 0);
+  output_link_.assign(terminal_.size(), 0);
+  std::vector<uint32_t> order;
+  order.reserve(terminal_.size());
+  for (size_t byte_class = 0; byte_class < classes_; ++byte_class) {
+    if (delta_[byte_class] != 0) {
+      order.push_back(delta_[byte_class]);
+    }
+  }
+  for (size_t head = 0; head < order.size(); ++head) {
+    uint32_t state = order[head];
+    uint32_t* row = delta_.data() + state * classes_;
+    const uint32_t* fallback = delta_.data() + fail[state] * classes_;
+    for (size_t byte_class = 0; byte_class < classes_; ++byte_class) {
+      uint32_t child = row[byte_class];
+      if (child == 0) {
+        row[byte_class] = fallback[byte_class];
+        continue;
+      }
+      uint32_t suffix = fallback[byte_class];
+      fail[child] = suffix;
+      output_link_[child] =
+          terminal_[suffix] != kNone ? suffix : output_link_[suffix];
+      order.push_back(child);
+    }
+  }
+  accepting_.assign(terminal_.size(), 0);
+  for (size_t state = 1; state < terminal_.size(); ++state) {
+    accepting_[state] = terminal_[state] != kNone || output_link_[state] != 0;
+  }
+}
+template <typename Visitor>
+void MultiSearcher::Scan(StringView haystack, Visitor visit) const {
+  const char* str = haystack.Data();
+  size_t state = 0;
+  for (size_t index = 0; index < haystack.Size(); ++index) {
+    state = delta_[state * classes_ +
+                   class_[static_cast<unsigned char>(str[index])]];
+    if (accepting_[state] == 0) {
+      continue;
+    }
+    for (uint32_t found = terminal_[state] != kNone ? state
+                                                    : output_link_[state];
+         found != 0; found = output_link_[found]) {
+      for (uint32_t id = terminal_[found]; id != kNone;
+           id = next_pattern_[id]) {
+        visit(id, index + 1 - lengths_[id]);
+      }
+    }
+  }
+}
+std::vector<MultiSearcher::Match> MultiSearcher::FindAll(
+    StringView haystack) const {
+  std::vector<Match> matches;
+  Scan(haystack, [&matches](size_t id, size_t pos) {
+    matches.push_back(Match{id, pos});
+  });
+  return matches;
+}
+std::vector<size_t> MultiSearcher::CountEach(StringView haystack) const {
+  std::vector<size_t> counts(lengths_.size(), 0);
+  Scan(haystack, [&counts](size_t id, size_t) { ++counts[id]; });
+  return counts;
+}
+size_t MultiSearcher::Count(StringView haystack) const {
+  size_t count = 0;
+  Scan(haystack, [&count](size_t, size_t) { ++count; });
+  return count;
+}
+bool MultiSearcher::Contains(StringView haystack) const {
+  const char* str = haystack.Data();
+  size_t state = 0;
+  for (size_t index = 0; index < haystack.Size(); ++index) {
+    state = delta_[state * classes_ +
+                   class_[static_cast<unsigned char>(str[index])]];
+    if (accepting_[state] != 0) {
+      return true;
+    }
+  }
+  return false;
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "string.hpp"
+class MultiSearcher {
+ public:
+  struct Match {
+    size_t pattern = 0;
+    size_t pos = 0;
+  };
+  explicit MultiSearcher(const std::vector<StringView>& patterns);
+  explicit MultiSearcher(const std::vector<String>& patterns);
+  std::vector<Match> FindAll(StringView haystack) const;
+  std::vector<size_t> CountEach(StringView haystack) const;
+  size_t Count(StringView haystack) const;
+  bool Contains(StringView haystack) const;
+  size_t PatternCount() const { return lengths_.size(); }
+  size_t StateCount() const { return terminal_.size(); }
+
+ private:
+  static constexpr uint32_t kNone = static_cast<uint32_t>(-1);
+  void Build(const std::vector<StringView>& patterns);
+  template <typename Visitor>
+  void Scan(StringView haystack, Visitor visit) const;
+  uint16_t class_[256] = {};
+  size_t classes_ = 1;
+  std::vector<uint32_t> delta_;
+  std::vector<char> accepting_;
+  std::vector<uint32_t> terminal_;
+  std::vector<uint32_t> output_link_;
+  std::vector<uint32_t> next_pattern_;
+  std::vector<size_t> lengths_;
+};
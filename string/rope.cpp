@@ -0,0 +1,176 @@
+#include "rope.hpp"
+Rope::Rope(String str) {
+  auto owner = std::make_shared<const String>(std::move(str));
+  root_ = MakeLeaf(owner, *owner);
+}
+Rope::Rope(StringView view) : root_(MakeLeaf(nullptr, view)) {}
+size_t Rope::Size() const { return root_ == nullptr ? 0 : root_->size; }
+unsigned int Rope::Depth() const {
+  return root_ == nullptr ? 0 : root_->depth;
+}
+char Rope::operator[](size_t index) const {
+  const Node* node = root_.get();
+  while (node->left != nullptr) {
+    if (index < node->left->size) {
+      node = node->left.get();
+    } else {
+      index -= node->left->size;
+      node = node->right.get();
+    }
+  }
+  return node->view[index];
+}
+Rope& Rope::operator+=(const Rope& other) {
+  root_ = Concat(root_, other.root_);
+  return *this;
+}
+Rope Rope::operator+(const Rope& other) const {
+  return Rope(Concat(root_, other.root_));
+}
+Rope Rope::operator*(int number) const {
+  NodePtr result;
+  NodePtr power = root_;
+  for (; number > 0; number >>= 1) {
+    if ((number & 1) != 0) {
+      result = Concat(result, power);
+    }
+    if (number > 1) {
+      power = Concat(power, power);
+    }
+  }
+  return Rope(result);
+}
+Rope& Rope::operator*=(int number) {
+  *this = *this * number;
+  return *this;
+}
+Rope Rope::Substr(size_t pos, size_t count) const {
+  pos = std::min(pos, Size());
+  return Rope(Substr(root_, pos, std::min(count, Size() - pos)));
+}
+String Rope::Flatten() const {
+  String result;
+  result.Reserve(Size());
+  for (StringView chunk : Chunks()) {
+    result += chunk;
+  }
+  return result;
+}
+std::vector<StringView> Rope::Chunks() const {
+  std::vector<StringView> chunks;
+  std::vector<const Node*> stack;
+  if (root_ != nullptr) {
+    stack.push_back(root_.get());
+  }
+  while (!stack.empty()) {
+    const Node* node = stack.back();
+    stack.pop_back();
+    if (node->left == nullptr) {
+      chunks.push_back(node->view);
+    } else {
+      stack.push_back(node->right.get());
+      stack.push_back(node->left.get());
+    }
+  }
+  return chunks;
+}
+std::ostream& operator<<(std::ostream& out, const Rope& rope) {
+  for (StringView chunk : rope.Chunks()) {
+    out << chunk;
+  }
+  return out;
+}
+Rope::NodePtr Rope::MakeLeaf(std::shared_ptr<const String> owner,
+                             StringView view) {
+  if (view.Empty()) {
+    return nullptr;
+  }
+  auto leaf = std::make_shared<Node>();
+  leaf->size = view.Size();
+  leaf->owner = std::move(owner);
+  leaf->view = view;
+  return leaf;
+}
+Rope::NodePtr Rope::MakeNode(const NodePtr& left, const NodePtr& right) {
+  auto node = std::make_shared<Node>();
+  node->size = left->size + right->size;
+  node->depth = std::max(left->depth, right->depth) + 1;
+  node->left = left;
+  node->right = right;
+  return node;
+}
+Rope::NodePtr Rope::Concat(const NodePtr& left, const NodePtr& right) {
+  if (left == nullptr) {
+    return right;
+  }
+  if (right == nullptr) {
+    return left;
+  }
+  if (left->left == nullptr && right->left == nullptr &&
+      left->size + right->size <= kLeafMergeSize) {
+    return Rope(String(left->view) + right->view).root_;
+  }
+  if (left->depth > right->depth + 1) {
+    return JoinRight(left, right);
+  }
+  if (right->depth > left->depth + 1) {
+    return JoinLeft(left, right);
+  }
+  return MakeNode(left, right);
+}
+Rope::NodePtr Rope::JoinRight(const NodePtr& left, const NodePtr& right) {
+  const NodePtr& outer = left->left;
+  const NodePtr& inner = left->right;
+  if (inner->depth <= right->depth + 1) {
+    NodePtr joined = MakeNode(inner, right);
+    if (joined->depth <= outer->depth + 1) {
+      return MakeNode(outer, joined);
+    }
+    return RotateLeft(MakeNode(outer, RotateRight(joined)));
+  }
+  NodePtr joined = JoinRight(inner, right);
+  NodePtr node = MakeNode(outer, joined);
+  return joined->depth <= outer->depth + 1 ? node : RotateLeft(node);
+}
+Rope::NodePtr Rope::JoinLeft(const NodePtr& left, const NodePtr& right) {
+  const NodePtr& inner = right->left;
+  const NodePtr& outer = right->right;
+  if (inner->depth <= left->depth + 1) {
+    NodePtr joined = MakeNode(left, inner);
+    if (joined->depth <= outer->depth + 1) {
+      return MakeNode(joined, outer);
+    }
+    return RotateRight(MakeNode(RotateLeft(joined), outer));
+  }
+  NodePtr joined = JoinLeft(left, inner);
+  NodePtr node = MakeNode(joined, outer);
+  return joined->depth <= outer->depth + 1 ? node : RotateRight(node);
+}
+Rope::NodePtr Rope::RotateLeft(const NodePtr& node) {
+  return MakeNode(MakeNode(node->left, node->right->left),
+                  node->right->right);
+}
+Rope::NodePtr Rope::RotateRight(const NodePtr& node) {
+  return MakeNode(node->left->left,
+                  MakeNode(node->left->right, node->right));
+}
+Rope::NodePtr Rope::Substr(const NodePtr& node, size_t pos, size_t count) {
+  if (node == nullptr || count == 0) {
+    return nullptr;
+  }
+  if (pos == 0 && count == node->size) {
+    return node;
+  }
+  if (node->left == nullptr) {
+    return MakeLeaf(node->owner, node->view.Substr(pos, count));
+  }
+  size_t left_size = node->left->size;
+  if (pos + count <= left_size) {
+    return Substr(node->left, pos, count);
+  }
+  if (pos >= left_size) {
+    return Substr(node->right, pos - left_size, count);
+  }
+  return Concat(Substr(node->left, pos, left_size - pos),
+                Substr(node->right, 0, pos + count - left_size));
+}
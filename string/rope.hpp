@@ -0,0 +1,47 @@
+#pragma once
+#include <memory>
+#include <vector>
+
+#include "string.hpp"
+class Rope {
+ public:
+  static const size_t kLeafMergeSize = 128;
+  Rope() = default;
+  explicit Rope(String str);
+  explicit Rope(StringView view);
+  size_t Size() const;
+  bool Empty() const { return Size() == 0; }
+  unsigned int Depth() const;
+  char operator[](size_t index) const;
+  Rope& operator+=(const Rope& other);
+  Rope operator+(const Rope& other) const;
+  Rope operator*(int number) const;
+  Rope& operator*=(int number);
+  Rope Substr(size_t pos, size_t count) const;
+  String Flatten() const;
+  std::vector<StringView> Chunks() const;
+  friend std::ostream& operator<<(std::ostream&, const Rope&);
+
+ private:
+  struct Node;
+  using NodePtr = std::shared_ptr<const Node>;
+  explicit Rope(NodePtr root) : root_(std::move(root)) {}
+  static NodePtr MakeLeaf(std::shared_ptr<const String> owner,
+                          StringView view);
+  static NodePtr MakeNode(const NodePtr& left, const NodePtr& right);
+  static NodePtr Concat(const NodePtr& left, const NodePtr& right);
+  static NodePtr JoinRight(const NodePtr& left, const NodePtr& right);
+  static NodePtr JoinLeft(const NodePtr& left, const NodePtr& right);
+  static NodePtr RotateLeft(const NodePtr& node);
+  static NodePtr RotateRight(const NodePtr& node);
+  static NodePtr Substr(const NodePtr& node, size_t pos, size_t count);
+  NodePtr root_;
+};
+struct Rope::Node {
+  size_t size = 0;
+  unsigned int depth = 0;
+  NodePtr left;
+  NodePtr right;
+  std::shared_ptr<const String> owner;
+  StringView view;
+};
@@ -0,0 +1,139 @@
+#include "shared_string.hpp"
+
+#include <new>
+SharedString::SharedString(const char* str) : SharedString(StringView(str)) {}
+SharedString::SharedString(StringView view) { *this += view; }
+SharedString::SharedString(const SharedString& other) {
+  if (other.header_ != nullptr && !other.header_->shareable) {
+    *this += other;
+    return;
+  }
+  header_ = other.header_;
+  if (header_ != nullptr) {
+    header_->references.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+SharedString::SharedString(SharedString&& other) noexcept
+    : header_(other.header_) {
+  other.header_ = nullptr;
+}
+SharedString& SharedString::operator=(const SharedString& other) {
+  SharedString newstr(other);
+  Swap(newstr);
+  return *this;
+}
+SharedString& SharedString::operator=(SharedString&& other) noexcept {
+  SharedString newstr(std::move(other));
+  Swap(newstr);
+  return *this;
+}
+SharedString::~SharedString() { Release(); }
+char& SharedString::operator[](size_t index) { return Leak()[index]; }
+const char& SharedString::operator[](size_t index) const {
+  return Data()[index];
+}
+char& SharedString::Front() { return Leak()[0]; }
+const char& SharedString::Front() const { return Data()[0]; }
+char& SharedString::Back() { return Leak()[Size() - 1]; }
+const char& SharedString::Back() const { return Data()[Size() - 1]; }
+const char* SharedString::Data() const {
+  return header_ == nullptr ? "" : Chars(header_);
+}
+char* SharedString::Data() { return Leak(); }
+size_t SharedString::Size() const {
+  return header_ == nullptr ? 0 : header_->size;
+}
+unsigned int SharedString::UseCount() const {
+  return header_ == nullptr
+             ? 0
+             : header_->references.load(std::memory_order_relaxed);
+}
+void SharedString::Clear() {
+  if (UseCount() > 1) {
+    Release();
+  } else if (header_ != nullptr) {
+    header_->size = 0;
+    Chars(header_)[0] = '\0';
+  }
+}
+void SharedString::PushBack(char character) {
+  MakeUnique(Size() + 1);
+  Chars(header_)[header_->size] = character;
+  ++header_->size;
+  Chars(header_)[header_->size] = '\0';
+}
+void SharedString::PopBack() {
+  if (Size() != 0) {
+    MakeUnique(Size());
+    --header_->size;
+    Chars(header_)[header_->size] = '\0';
+  }
+}
+SharedString& SharedString::operator+=(StringView other) {
+  if (other.Empty()) {
+    return *this;
+  }
+  StringView current = *this;
+  if (other.Data() >= current.Data() &&
+      other.Data() < current.Data() + current.Size()) {
+    size_t offset = other.Data() - current.Data();
+    MakeUnique(Size() + other.Size());
+    other = StringView(Chars(header_) + offset, other.Size());
+  } else {
+    MakeUnique(Size() + other.Size());
+  }
+  memcpy(Chars(header_) + header_->size, other.Data(), other.Size());
+  header_->size += other.Size();
+  Chars(header_)[header_->size] = '\0';
+  return *this;
+}
+void SharedString::Swap(SharedString& other) noexcept {
+  std::swap(header_, other.header_);
+}
+bool SharedString::operator==(StringView other) const {
+  return StringView(*this) == other;
+}
+bool SharedString::operator!=(StringView other) const {
+  return StringView(*this) != other;
+}
+std::strong_ordering SharedString::operator<=>(StringView other) const {
+  return StringView(*this) <=> other;
+}
+char* SharedString::Chars(Header* header) {
+  return reinterpret_cast<char*>(header + 1);
+}
+SharedString::Header* SharedString::Allocate(size_t capacity) {
+  void* memory = ::operator new(sizeof(Header) + capacity + 1);
+  Header* header = new (memory) Header();
+  header->capacity = capacity;
+  return header;
+}
+void SharedString::Release() {
+  if (header_ != nullptr &&
+      header_->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    header_->~Header();
+    ::operator delete(header_);
+  }
+  header_ = nullptr;
+}
+void SharedString::MakeUnique(size_t required) {
+  if (header_ != nullptr && header_->capacity >= required &&
+      header_->references.load(std::memory_order_acquire) == 1) {
+    return;
+  }
+  size_t capacity = required;
+  if (header_ != nullptr && header_->capacity < required) {
+    capacity = std::max(required, 2 * header_->capacity);
+  }
+  StringView current = *this;
+  Header* header = Allocate(capacity);
+  header->size = current.Size();
+  memcpy(Chars(header), current.Data(), current.Size() + 1);
+  Release();
+  header_ = header;
+}
+char* SharedString::Leak() {
+  MakeUnique(Size());
+  header_->shareable = false;
+  return Chars(header_);
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <atomic>
+
+#include "string.hpp"
+class SharedString {
+ public:
+  SharedString() = default;
+  SharedString(const char* str);
+  explicit SharedString(StringView view);
+  SharedString(const SharedString& other);
+  SharedString(SharedString&& other) noexcept;
+  SharedString& operator=(const SharedString& other);
+  SharedString& operator=(SharedString&& other) noexcept;
+  ~SharedString();
+  char& operator[](size_t index);
+  const char& operator[](size_t index) const;
+  char& Front();
+  const char& Front() const;
+  char& Back();
+  const char& Back() const;
+  const char* Data() const;
+  char* Data();
+  size_t Size() const;
+  bool Empty() const { return Size() == 0; }
+  unsigned int UseCount() const;
+  operator StringView() const { return StringView(Data(), Size()); }
+  String ToString() const { return String(StringView(*this)); }
+  void Clear();
+  void PushBack(char character);
+  void PopBack();
+  SharedString& operator+=(StringView other);
+  void Swap(SharedString& other) noexcept;
+  bool operator==(StringView other) const;
+  bool operator!=(StringView other) const;
+  std::strong_ordering operator<=>(StringView other) const;
+
+ private:
+  struct Header {
+    std::atomic<unsigned int> references{1};
+    size_t size = 0;
+    size_t capacity = 0;
+    bool shareable = true;
+  };
+  static char* Chars(Header* header);
+  static Header* Allocate(size_t capacity);
+  void Release();
+  void MakeUnique(size_t required);
+  char* Leak();
+  Header* header_ = nullptr;
+};
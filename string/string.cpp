@@ -1,20 +1,909 @@
 #include "string.hpp"
-String::String(unsigned int size, char character)
-    : size_(size), capacity_(size_ * 2) {
-  str_ = new char[capacity_];
-  std::fill(str_, str_ + size_, character);
+
+#include <bit>
+#include <charconv>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#if defined(__SSE2__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+namespace {
+const char* FindByte(const char* first, const char* last, char byte) {
+#if defined(__AVX2__)
+  const __m256i pattern32 = _mm256_set1_epi8(byte);
+  for (; last - first >= 32; first += 32) {
+    __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+    unsigned int mask =
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(block, pattern32));
+    if (mask != 0) {
+      return first + std::countr_zero(mask);
+    }
+  }
+#endif
+#if defined(__SSE2__)
+  const __m128i pattern16 = _mm_set1_epi8(byte);
+  for (; last - first >= 16; first += 16) {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+    unsigned int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, pattern16));
+    if (mask != 0) {
+      return first + std::countr_zero(mask);
+    }
+  }
+#endif
+  for (; first != last; ++first) {
+    if (*first == byte) {
+      return first;
+    }
+  }
+  return last;
+}
+const char* FindSubstring(const char* first, const char* last,
+                          StringView needle) {
+  if (static_cast<size_t>(last - first) < needle.Size()) {
+    return last;
+  }
+  const char* candidates_end = last - needle.Size() + 1;
+  while (first != candidates_end) {
+    first = FindByte(first, candidates_end, needle[0]);
+    if (first == candidates_end) {
+      break;
+    }
+    if (memcmp(first + 1, needle.Data() + 1, needle.Size() - 1) == 0) {
+      return first;
+    }
+    ++first;
+  }
+  return last;
+}
+const char* FindShort(const char* first, const char* last, StringView needle) {
+  if (static_cast<size_t>(last - first) < needle.Size()) {
+    return last;
+  }
+#if defined(__SSE2__)
+  const char* candidates_end = last - needle.Size() + 1;
+  const __m128i head = _mm_set1_epi8(needle.Front());
+  const __m128i tail = _mm_set1_epi8(needle.Back());
+  for (; candidates_end - first >= 16; first += 16) {
+    __m128i block_head =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+    __m128i block_tail = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(first + needle.Size() - 1));
+    unsigned int mask = _mm_movemask_epi8(_mm_and_si128(
+        _mm_cmpeq_epi8(block_head, head), _mm_cmpeq_epi8(block_tail, tail)));
+    for (; mask != 0; mask &= mask - 1) {
+      const char* candidate = first + std::countr_zero(mask);
+      if (memcmp(candidate + 1, needle.Data() + 1, needle.Size() - 2) == 0) {
+        return candidate;
+      }
+    }
+  }
+#endif
+  return FindSubstring(first, last, needle);
+}
+const char* RFindByte(const char* first, const char* last, char byte) {
+#if defined(__AVX2__)
+  const __m256i pattern32 = _mm256_set1_epi8(byte);
+  for (; last - first >= 32; last -= 32) {
+    __m256i block =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(last - 32));
+    unsigned int mask =
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(block, pattern32));
+    if (mask != 0) {
+      return last - 32 + (31 - std::countl_zero(mask));
+    }
+  }
+#endif
+#if defined(__SSE2__)
+  const __m128i pattern16 = _mm_set1_epi8(byte);
+  for (; last - first >= 16; last -= 16) {
+    __m128i block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(last - 16));
+    unsigned int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, pattern16));
+    if (mask != 0) {
+      return last - 16 + (31 - std::countl_zero(mask));
+    }
+  }
+#endif
+  while (last != first) {
+    if (*--last == byte) {
+      return last;
+    }
+  }
+  return nullptr;
+}
+const char* RFindShort(const char* first, const char* candidates_end,
+                       StringView needle) {
+#if defined(__SSE2__)
+  const __m128i head = _mm_set1_epi8(needle.Front());
+  const __m128i tail = _mm_set1_epi8(needle.Back());
+  for (; candidates_end - first >= 16; candidates_end -= 16) {
+    const char* block = candidates_end - 16;
+    __m128i block_head =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+    __m128i block_tail = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(block + needle.Size() - 1));
+    unsigned int mask = _mm_movemask_epi8(_mm_and_si128(
+        _mm_cmpeq_epi8(block_head, head), _mm_cmpeq_epi8(block_tail, tail)));
+    while (mask != 0) {
+      unsigned int offset = 31 - std::countl_zero(mask);
+      if (memcmp(block + offset + 1, needle.Data() + 1, needle.Size() - 2) ==
+          0) {
+        return block + offset;
+      }
+      mask &= ~(1u << offset);
+    }
+  }
+#endif
+  while (candidates_end != first) {
+    const char* candidate = --candidates_end;
+    if (*candidate == needle.Front() &&
+        memcmp(candidate + 1, needle.Data() + 1, needle.Size() - 1) == 0) {
+      return candidate;
+    }
+  }
+  return nullptr;
+}
+const char* RFindLong(const char* first, const char* candidates_end,
+                      StringView needle) {
+  size_t shift[256];
+  std::fill(shift, shift + 256, needle.Size());
+  for (size_t index = needle.Size() - 1; index > 0; --index) {
+    shift[static_cast<unsigned char>(needle[index])] = index;
+  }
+  const char* candidate = candidates_end - 1;
+  while (true) {
+    if (*candidate == needle.Front() &&
+        memcmp(candidate + 1, needle.Data() + 1, needle.Size() - 1) == 0) {
+      return candidate;
+    }
+    size_t step = shift[static_cast<unsigned char>(*candidate)];
+    if (static_cast<size_t>(candidate - first) < step) {
+      return nullptr;
+    }
+    candidate -= step;
+  }
+}
+const char* FindAnyByte(const char* first, const char* last,
+                        StringView bytes) {
+#if defined(__SSE2__)
+  __m128i patterns[4];
+  for (size_t index = 0; index < 4; ++index) {
+    patterns[index] = _mm_set1_epi8(bytes[std::min(index, bytes.Size() - 1)]);
+  }
+  for (; last - first >= 16; first += 16) {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+    __m128i matches = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(block, patterns[0]),
+                     _mm_cmpeq_epi8(block, patterns[1])),
+        _mm_or_si128(_mm_cmpeq_epi8(block, patterns[2]),
+                     _mm_cmpeq_epi8(block, patterns[3])));
+    unsigned int mask = _mm_movemask_epi8(matches);
+    if (mask != 0) {
+      return first + std::countr_zero(mask);
+    }
+  }
+#endif
+  for (; first != last; ++first) {
+    if (memchr(bytes.Data(), *first, bytes.Size()) != nullptr) {
+      return first;
+    }
+  }
+  return last;
+}
+void FillRepeated(char* str, size_t filled, size_t length) {
+  if (filled == 0) {
+    return;
+  }
+  while (filled < length) {
+    size_t chunk = std::min(filled, length - filled);
+    memcpy(str + filled, str, chunk);
+    filled += chunk;
+  }
+}
+void FlipCase(const char* src, char* dst, size_t length, char first,
+              char last) {
+  const char* end = src + length;
+#if defined(__AVX2__)
+  const __m256i lower32 = _mm256_set1_epi8(static_cast<char>(first - 1));
+  const __m256i upper32 = _mm256_set1_epi8(static_cast<char>(last + 1));
+  const __m256i flip32 = _mm256_set1_epi8(0x20);
+  for (; end - src >= 32; src += 32, dst += 32) {
+    __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+    __m256i in_range = _mm256_and_si256(_mm256_cmpgt_epi8(block, lower32),
+                                        _mm256_cmpgt_epi8(upper32, block));
+    block = _mm256_xor_si256(block, _mm256_and_si256(in_range, flip32));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), block);
+  }
+#endif
+#if defined(__SSE2__)
+  const __m128i lower16 = _mm_set1_epi8(static_cast<char>(first - 1));
+  const __m128i upper16 = _mm_set1_epi8(static_cast<char>(last + 1));
+  const __m128i flip16 = _mm_set1_epi8(0x20);
+  for (; end - src >= 16; src += 16, dst += 16) {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    __m128i in_range = _mm_and_si128(_mm_cmpgt_epi8(block, lower16),
+                                     _mm_cmplt_epi8(block, upper16));
+    block = _mm_xor_si128(block, _mm_and_si128(in_range, flip16));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), block);
+  }
+#endif
+  for (; src != end; ++src, ++dst) {
+    *dst = (*src >= first && *src <= last) ? static_cast<char>(*src ^ 0x20)
+                                           : *src;
+  }
+}
+void ReplaceByte(const char* src, char* dst, size_t length, char from,
+                 char to) {
+  const char* end = src + length;
+#if defined(__AVX2__)
+  const __m256i from32 = _mm256_set1_epi8(from);
+  const __m256i to32 = _mm256_set1_epi8(to);
+  for (; end - src >= 32; src += 32, dst += 32) {
+    __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+    block = _mm256_blendv_epi8(block, to32, _mm256_cmpeq_epi8(block, from32));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), block);
+  }
+#endif
+#if defined(__SSE2__)
+  const __m128i from16 = _mm_set1_epi8(from);
+  const __m128i to16 = _mm_set1_epi8(to);
+  for (; end - src >= 16; src += 16, dst += 16) {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    __m128i matches = _mm_cmpeq_epi8(block, from16);
+    block = _mm_or_si128(_mm_and_si128(matches, to16),
+                         _mm_andnot_si128(matches, block));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), block);
+  }
+#endif
+  for (; src != end; ++src, ++dst) {
+    *dst = *src == from ? to : *src;
+  }
+}
+void AppendReplaced(String& out, StringView str, StringView from,
+                    StringView to) {
+  if (from.Empty()) {
+    out += str;
+    return;
+  }
+  StringSearcher searcher(from);
+  size_t count = searcher.Count(str);
+  out.Reserve(out.Size() + str.Size() - count * from.Size() +
+              count * to.Size());
+  size_t last = 0;
+  for (size_t found = searcher.Find(str); found != StringView::kNpos;
+       found = searcher.Find(str, last)) {
+    out.Append(str.Data() + last, found - last);
+    out += to;
+    last = found + from.Size();
+  }
+  out.Append(str.Data() + last, str.Size() - last);
+}
+bool IsContinuation(unsigned char byte) { return (byte & 0xC0) == 0x80; }
+bool DecodeCodePoint(const char*& current, const char* end,
+                     char32_t& code_point) {
+  const unsigned char* bytes = reinterpret_cast<const unsigned char*>(current);
+  size_t available = end - current;
+  unsigned char lead = bytes[0];
+  size_t length = 0;
+  unsigned char second_min = 0x80;
+  unsigned char second_max = 0xBF;
+  if (lead < 0x80) {
+    code_point = lead;
+    ++current;
+    return true;
+  }
+  if (lead >= 0xC2 && lead <= 0xDF) {
+    length = 2;
+    code_point = lead & 0x1F;
+  } else if (lead >= 0xE0 && lead <= 0xEF) {
+    length = 3;
+    code_point = lead & 0x0F;
+    second_min = lead == 0xE0 ? 0xA0 : 0x80;
+    second_max = lead == 0xED ? 0x9F : 0xBF;
+  } else if (lead >= 0xF0 && lead <= 0xF4) {
+    length = 4;
+    code_point = lead & 0x07;
+    second_min = lead == 0xF0 ? 0x90 : 0x80;
+    second_max = lead == 0xF4 ? 0x8F : 0xBF;
+  }
+  bool valid = length != 0 && available >= length &&
+               bytes[1] >= second_min && bytes[1] <= second_max;
+  for (size_t index = 1; valid && index < length; ++index) {
+    valid = IsContinuation(bytes[index]);
+    code_point = (code_point << 6) | (bytes[index] & 0x3F);
+  }
+  if (!valid) {
+    code_point = CodePointIterator::kReplacement;
+    ++current;
+    return false;
+  }
+  current += length;
+  return true;
+}
+size_t EncodeCodePoint(char32_t code_point, char* out) {
+  if (code_point < 0x80) {
+    out[0] = static_cast<char>(code_point);
+    return 1;
+  }
+  if (code_point < 0x800) {
+    out[0] = static_cast<char>(0xC0 | (code_point >> 6));
+    out[1] = static_cast<char>(0x80 | (code_point & 0x3F));
+    return 2;
+  }
+  if (code_point >= 0xD800 && code_point <= 0xDFFF) {
+    code_point = CodePointIterator::kReplacement;
+  }
+  if (code_point < 0x10000) {
+    out[0] = static_cast<char>(0xE0 | (code_point >> 12));
+    out[1] = static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+    out[2] = static_cast<char>(0x80 | (code_point & 0x3F));
+    return 3;
+  }
+  if (code_point > 0x10FFFF) {
+    return EncodeCodePoint(CodePointIterator::kReplacement, out);
+  }
+  out[0] = static_cast<char>(0xF0 | (code_point >> 18));
+  out[1] = static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+  out[2] = static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+  out[3] = static_cast<char>(0x80 | (code_point & 0x3F));
+  return 4;
+}
+const char* SkipAscii(const char* first, const char* last) {
+#if defined(__AVX2__)
+  for (; last - first >= 32; first += 32) {
+    __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+    if (_mm256_movemask_epi8(block) != 0) {
+      break;
+    }
+  }
+#endif
+#if defined(__SSE2__)
+  for (; last - first >= 16; first += 16) {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+    if (_mm_movemask_epi8(block) != 0) {
+      break;
+    }
+  }
+#endif
+  while (first != last && static_cast<unsigned char>(*first) < 0x80) {
+    ++first;
+  }
+  return first;
+}
+template <typename Function>
+void ParallelFor(unsigned int tasks, Function function) {
+  std::vector<std::exception_ptr> errors(tasks);
+  auto run = [&function, &errors](unsigned int task) {
+    try {
+      function(task);
+    } catch (...) {
+      errors[task] = std::current_exception();
+    }
+  };
+  std::vector<std::thread> workers;
+  workers.reserve(tasks - 1);
+  for (unsigned int task = 1; task < tasks; ++task) {
+    workers.emplace_back(run, task);
+  }
+  run(0);
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+  for (const std::exception_ptr& error : errors) {
+    if (error != nullptr) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+unsigned int ChooseTasks(size_t size, unsigned int threads) {
+  if (threads == 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  return std::max<size_t>(
+      1, std::min<size_t>(threads, size / StringView::kParallelChunkSize));
+}
+bool HasBorder(StringView str) {
+  for (size_t length = 1; length < str.Size(); ++length) {
+    if (str.Substr(0, length) == str.Substr(str.Size() - length, length)) {
+      return true;
+    }
+  }
+  return false;
+}
+bool IsSpace(char character) {
+  return character == ' ' || (character >= '\t' && character <= '\r');
+}
+size_t CountByte(const char* first, const char* last, char byte) {
+  size_t count = 0;
+#if defined(__SSE2__)
+  const __m128i pattern = _mm_set1_epi8(byte);
+  for (; last - first >= 16; first += 16) {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+    count += std::popcount(static_cast<unsigned int>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(block, pattern))));
+  }
+#endif
+  for (; first != last; ++first) {
+    count += *first == byte ? 1 : 0;
+  }
+  return count;
+}
+const uint64_t kHashSecret[4] = {0xa0761d6478bd642full, 0xe7037ed1a0b428dbull,
+                                 0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull};
+uint64_t Read64(const char* str) {
+  uint64_t value;
+  memcpy(&value, str, sizeof(value));
+  return value;
+}
+uint64_t Read32(const char* str) {
+  uint32_t value;
+  memcpy(&value, str, sizeof(value));
+  return value;
+}
+uint64_t ReadShort(const char* str, size_t length) {
+  return (static_cast<uint64_t>(static_cast<unsigned char>(str[0])) << 16) |
+         (static_cast<uint64_t>(static_cast<unsigned char>(str[length >> 1]))
+          << 8) |
+         static_cast<unsigned char>(str[length - 1]);
+}
+void Multiply(uint64_t& low, uint64_t& high) {
+#if defined(__SIZEOF_INT128__)
+  __uint128_t product = static_cast<__uint128_t>(low) * high;
+  low = static_cast<uint64_t>(product);
+  high = static_cast<uint64_t>(product >> 64);
+#else
+  uint64_t a_high = low >> 32;
+  uint64_t b_high = high >> 32;
+  uint64_t a_low = static_cast<uint32_t>(low);
+  uint64_t b_low = static_cast<uint32_t>(high);
+  uint64_t cross_first = a_high * b_low;
+  uint64_t cross_second = b_high * a_low;
+  uint64_t bottom = a_low * b_low;
+  uint64_t middle = bottom + (cross_first << 32);
+  uint64_t carry = middle < bottom ? 1 : 0;
+  low = middle + (cross_second << 32);
+  carry += low < middle ? 1 : 0;
+  high = a_high * b_high + (cross_first >> 32) + (cross_second >> 32) + carry;
+#endif
+}
+uint64_t Mix(uint64_t first, uint64_t second) {
+  Multiply(first, second);
+  return first ^ second;
+}
+uint64_t HashBytes(const char* str, size_t length, uint64_t seed) {
+  seed ^= Mix(seed ^ kHashSecret[0], kHashSecret[1]);
+  uint64_t first = 0;
+  uint64_t second = 0;
+  if (length <= 16) {
+    if (length >= 4) {
+      size_t step = (length >> 3) << 2;
+      first = (Read32(str) << 32) | Read32(str + step);
+      second =
+          (Read32(str + length - 4) << 32) | Read32(str + length - 4 - step);
+    } else if (length > 0) {
+      first = ReadShort(str, length);
+    }
+  } else {
+    size_t rest = length;
+    if (rest > 48) {
+      uint64_t lane_first = seed;
+      uint64_t lane_second = seed;
+      for (; rest > 48; str += 48, rest -= 48) {
+        seed = Mix(Read64(str) ^ kHashSecret[1], Read64(str + 8) ^ seed);
+        lane_first = Mix(Read64(str + 16) ^ kHashSecret[2],
+                         Read64(str + 24) ^ lane_first);
+        lane_second = Mix(Read64(str + 32) ^ kHashSecret[3],
+                          Read64(str + 40) ^ lane_second);
+      }
+      seed ^= lane_first ^ lane_second;
+    }
+    for (; rest > 16; str += 16, rest -= 16) {
+      seed = Mix(Read64(str) ^ kHashSecret[1], Read64(str + 8) ^ seed);
+    }
+    first = Read64(str + rest - 16);
+    second = Read64(str + rest - 8);
+  }
+  first ^= kHashSecret[1];
+  second ^= seed;
+  Multiply(first, second);
+  return Mix(first ^ kHashSecret[0] ^ length, second ^ kHashSecret[1]);
+}
+}  // namespace
+StringView::StringView(const char* str) : str_(str), size_(strlen(str)) {}
+StringView::StringView(const char* str, size_t length)
+    : str_(str), size_(length) {}
+const char& StringView::operator[](size_t index) const { return str_[index]; }
+const char& StringView::Front() const { return str_[0]; }
+const char& StringView::Back() const { return str_[size_ - 1]; }
+StringView StringView::Substr(size_t pos, size_t count) const {
+  pos = std::min(pos, size_);
+  return StringView(str_ + pos, std::min(count, size_ - pos));
+}
+void StringView::RemovePrefix(size_t count) {
+  str_ += count;
+  size_ -= count;
+}
+void StringView::RemoveSuffix(size_t count) { size_ -= count; }
+size_t StringView::Hash() const { return HashBytes(str_, size_, 0); }
+StringView StringView::TrimLeft() const {
+  size_t skipped = 0;
+  while (skipped < size_ && IsSpace(str_[skipped])) {
+    ++skipped;
+  }
+  return StringView(str_ + skipped, size_ - skipped);
+}
+StringView StringView::TrimRight() const {
+  size_t length = size_;
+  while (length > 0 && IsSpace(str_[length - 1])) {
+    --length;
+  }
+  return StringView(str_, length);
+}
+StringView StringView::Trim() const { return TrimLeft().TrimRight(); }
+String StringView::ToLower() const {
+  String newstr;
+  newstr.Resize(size_);
+  FlipCase(str_, newstr.Data(), size_, 'A', 'Z');
+  return newstr;
+}
+String StringView::ToUpper() const {
+  String newstr;
+  newstr.Resize(size_);
+  FlipCase(str_, newstr.Data(), size_, 'a', 'z');
+  return newstr;
+}
+String StringView::ReplaceAll(char from, char to) const {
+  String newstr;
+  newstr.Resize(size_);
+  ReplaceByte(str_, newstr.Data(), size_, from, to);
+  return newstr;
+}
+String StringView::ReplaceAll(StringView from, StringView to) const {
+  String newstr;
+  AppendReplaced(newstr, *this, from, to);
+  return newstr;
+}
+int StringView::Compare(StringView other) const {
+  size_t common = std::min(size_, other.size_);
+  int result = common == 0 ? 0 : memcmp(str_, other.str_, common);
+  if (result != 0) {
+    return result;
+  }
+  if (size_ != other.size_) {
+    return size_ < other.size_ ? -1 : 1;
+  }
+  return 0;
+}
+std::strong_ordering StringView::operator<=>(StringView other) const {
+  return Compare(other) <=> 0;
+}
+bool StringView::operator==(StringView other) const {
+  return size_ == other.size_ &&
+         (size_ == 0 || memcmp(str_, other.str_, size_) == 0);
+}
+bool StringView::operator!=(StringView other) const {
+  return !(operator==(other));
+}
+bool StringView::operator>(StringView other) const {
+  return Compare(other) > 0;
+}
+bool StringView::operator<(StringView other) const {
+  return Compare(other) < 0;
+}
+bool StringView::operator>=(StringView other) const {
+  return Compare(other) >= 0;
+}
+bool StringView::operator<=(StringView other) const {
+  return Compare(other) <= 0;
+}
+std::vector<StringView> StringView::Split(StringView delim) const {
+  std::vector<StringView> pieces;
+  const char* first = str_;
+  const char* last = str_ + size_;
+  if (!delim.Empty()) {
+    StringSearcher searcher(delim);
+    for (size_t found = searcher.Find(*this); found != kNpos;
+         found = searcher.Find(*this, first - str_)) {
+      pieces.emplace_back(first, str_ + found - first);
+      first = str_ + found + delim.size_;
+    }
+  }
+  pieces.emplace_back(first, last - first);
+  return pieces;
+}
+size_t StringView::Find(StringView needle, size_t pos) const {
+  return StringSearcher(needle).Find(*this, pos);
+}
+size_t StringView::Find(char character, size_t pos) const {
+  if (pos >= size_) {
+    return kNpos;
+  }
+  const char* found = FindByte(str_ + pos, str_ + size_, character);
+  return found == str_ + size_ ? kNpos : found - str_;
+}
+size_t StringView::RFind(StringView needle, size_t pos) const {
+  if (needle.size_ > size_) {
+    return kNpos;
+  }
+  size_t last_start = std::min(pos, size_ - needle.size_);
+  if (needle.size_ == 0) {
+    return last_start;
+  }
+  if (needle.size_ == 1) {
+    return RFind(needle[0], last_start);
+  }
+  const char* candidates_end = str_ + last_start + 1;
+  const char* found = needle.size_ < StringSearcher::kHorspoolThreshold
+                          ? RFindShort(str_, candidates_end, needle)
+                          : RFindLong(str_, candidates_end, needle);
+  return found == nullptr ? kNpos : found - str_;
+}
+size_t StringView::RFind(char character, size_t pos) const {
+  const char* found =
+      RFindByte(str_, str_ + (pos < size_ ? pos + 1 : size_), character);
+  return found == nullptr ? kNpos : found - str_;
+}
+size_t StringView::FindFirstOf(StringView characters, size_t pos) const {
+  if (pos >= size_ || characters.size_ == 0) {
+    return kNpos;
+  }
+  if (characters.size_ == 1) {
+    return Find(characters[0], pos);
+  }
+  if (characters.size_ <= 4) {
+    const char* found = FindAnyByte(str_ + pos, str_ + size_, characters);
+    return found == str_ + size_ ? kNpos : found - str_;
+  }
+  bool accepted[256] = {};
+  for (size_t index = 0; index < characters.size_; ++index) {
+    accepted[static_cast<unsigned char>(characters[index])] = true;
+  }
+  for (size_t index = pos; index < size_; ++index) {
+    if (accepted[static_cast<unsigned char>(str_[index])]) {
+      return index;
+    }
+  }
+  return kNpos;
+}
+bool StringView::Contains(StringView needle) const {
+  return Find(needle) != kNpos;
+}
+bool StringView::Contains(char character) const {
+  return Find(character) != kNpos;
+}
+size_t StringView::Count(StringView needle) const {
+  return StringSearcher(needle).Count(*this);
+}
+size_t StringView::Count(char character) const {
+  return CountByte(str_, str_ + size_, character);
+}
+std::vector<StringView> StringView::Split(char delim) const {
+  return Split(StringView(&delim, 1));
+}
+std::vector<StringView> StringView::Split(char32_t delim) const {
+  char encoded[4];
+  return Split(StringView(encoded, EncodeCodePoint(delim, encoded)));
+}
+bool StringView::IsValidUtf8() const {
+  const char* current = str_;
+  const char* end = str_ + size_;
+  char32_t code_point;
+  while ((current = SkipAscii(current, end)) != end) {
+    if (!DecodeCodePoint(current, end, code_point)) {
+      return false;
+    }
+  }
+  return true;
+}
+size_t StringView::CodePointCount() const {
+  const char* current = str_;
+  const char* end = str_ + size_;
+  char32_t code_point;
+  size_t count = 0;
+  while (current != end) {
+    const char* ascii_end = SkipAscii(current, end);
+    count += ascii_end - current;
+    current = ascii_end;
+    if (current != end) {
+      DecodeCodePoint(current, end, code_point);
+      ++count;
+    }
+  }
+  return count;
+}
+CodePointRange StringView::CodePoints() const { return CodePointRange(*this); }
+CodePointIterator::CodePointIterator(const char* current, const char* end)
+    : current_(current), end_(end) {
+  Decode();
+}
+CodePointIterator& CodePointIterator::operator++() {
+  current_ = next_;
+  Decode();
+  return *this;
+}
+CodePointIterator CodePointIterator::operator++(int) {
+  CodePointIterator copy(*this);
+  operator++();
+  return copy;
+}
+void CodePointIterator::Decode() {
+  next_ = current_;
+  if (current_ != end_) {
+    DecodeCodePoint(next_, end_, code_point_);
+  }
+}
+std::vector<StringView> StringView::ParallelSplit(StringView delim,
+                                                  unsigned int threads) const {
+  unsigned int tasks = ChooseTasks(size_, threads);
+  if (tasks == 1 || delim.Empty() || HasBorder(delim)) {
+    return Split(delim);
+  }
+  StringSearcher searcher(delim);
+  std::vector<std::vector<size_t>> found(tasks);
+  ParallelFor(tasks, [&](unsigned int task) {
+    size_t begin = size_ * task / tasks;
+    size_t end = size_ * (task + 1) / tasks;
+    StringView window = Substr(0, end + delim.size_ - 1);
+    for (size_t pos = searcher.Find(window, begin); pos < end;
+         pos = searcher.Find(window, pos + delim.size_)) {
+      found[task].push_back(pos);
+    }
+  });
+  std::vector<size_t> offsets(tasks + 1, 0);
+  std::vector<size_t> previous_end(tasks, 0);
+  for (unsigned int task = 0; task < tasks; ++task) {
+    offsets[task + 1] = offsets[task] + found[task].size();
+    if (task + 1 < tasks) {
+      previous_end[task + 1] = found[task].empty()
+                                   ? previous_end[task]
+                                   : found[task].back() + delim.size_;
+    }
+  }
+  std::vector<StringView> pieces(offsets[tasks] + 1);
+  ParallelFor(tasks, [&](unsigned int task) {
+    size_t start = previous_end[task];
+    for (size_t index = 0; index < found[task].size(); ++index) {
+      pieces[offsets[task] + index] =
+          StringView(str_ + start, found[task][index] - start);
+      start = found[task][index] + delim.size_;
+    }
+  });
+  size_t last_end = 0;
+  for (unsigned int task = tasks; task-- > 0;) {
+    if (!found[task].empty()) {
+      last_end = found[task].back() + delim.size_;
+      break;
+    }
+  }
+  pieces.back() = StringView(str_ + last_end, size_ - last_end);
+  return pieces;
+}
+long long StringView::ParseInt() const {
+  long long value = 0;
+  auto [end, error] = std::from_chars(str_, str_ + size_, value);
+  if (error == std::errc::result_out_of_range) {
+    throw std::out_of_range("StringView::ParseInt");
+  }
+  if (error != std::errc() || end != str_ + size_) {
+    throw std::invalid_argument("StringView::ParseInt");
+  }
+  return value;
+}
+double StringView::ParseDouble() const {
+  double value = 0;
+  auto [end, error] = std::from_chars(str_, str_ + size_, value);
+  if (error == std::errc::result_out_of_range) {
+    throw std::out_of_range("StringView::ParseDouble");
+  }
+  if (error != std::errc() || end != str_ + size_) {
+    throw std::invalid_argument("StringView::ParseDouble");
+  }
+  return value;
+}
+StringSearcher::StringSearcher(StringView needle) : needle_(needle) {
+  if (needle_.Size() >= kHorspoolThreshold) {
+    std::fill(shift_, shift_ + 256, needle_.Size());
+    for (size_t index = 0; index + 1 < needle_.Size(); ++index) {
+      shift_[static_cast<unsigned char>(needle_[index])] =
+          needle_.Size() - 1 - index;
+    }
+  }
+}
+size_t StringSearcher::Find(StringView haystack, size_t pos) const {
+  size_t size = needle_.Size();
+  if (pos > haystack.Size() || size > haystack.Size() - pos) {
+    return StringView::kNpos;
+  }
+  if (size == 0) {
+    return pos;
+  }
+  if (size == 1) {
+    return haystack.Find(needle_[0], pos);
+  }
+  const char* first = haystack.Data() + pos;
+  const char* last = haystack.Data() + haystack.Size();
+  if (size < kHorspoolThreshold) {
+    const char* found = FindShort(first, last, needle_);
+    return found == last ? StringView::kNpos : found - haystack.Data();
+  }
+  for (; size <= static_cast<size_t>(last - first);
+       first += shift_[static_cast<unsigned char>(first[size - 1])]) {
+    if (first[size - 1] == needle_.Back() &&
+        memcmp(first, needle_.Data(), size - 1) == 0) {
+      return first - haystack.Data();
+    }
+  }
+  return StringView::kNpos;
+}
+size_t StringSearcher::Count(StringView haystack) const {
+  if (needle_.Empty()) {
+    return haystack.Size() + 1;
+  }
+  size_t count = 0;
+  for (size_t pos = Find(haystack); pos != StringView::kNpos;
+       pos = Find(haystack, pos + needle_.Size())) {
+    ++count;
+  }
+  return count;
+}
+bool StringSearcher::Contains(StringView haystack) const {
+  return Find(haystack) != StringView::kNpos;
+}
+std::ostream& operator<<(std::ostream& out, StringView output) {
+  return out.write(output.str_, output.size_);
+}
+String::String(const allocator_type& alloc) : resource_(alloc.resource()) {}
+String::String(unsigned int size, char character, const allocator_type& alloc)
+    : resource_(alloc.resource()) {
+  Reserve(size);
+  std::fill(str_, str_ + size, character);
+  size_ = size;
   str_[size_] = '\0';
 }
-String::String(const char* str) : size_(strlen(str)), capacity_(size_ * 2 + 1) {
-  if (capacity_ > 0) {
-    str_ = new char[capacity_];
-    std::copy(str, str + size_, str_);
-    str_[size_] = '\0';
+String::String(const char* str, const allocator_type& alloc)
+    : resource_(alloc.resource()) {
+  unsigned int length = strlen(str);
+  Reserve(length);
+  std::copy(str, str + length, str_);
+  size_ = length;
+  str_[size_] = '\0';
+}
+String::String(StringView view, const allocator_type& alloc)
+    : resource_(alloc.resource()) {
+  Reserve(view.Size());
+  Append(view.Data(), view.Size());
+}
+String::String(const String& other) {
+  Reserve(other.size_);
+  std::copy(other.str_, other.str_ + other.size_, str_);
+  size_ = other.size_;
+  str_[size_] = '\0';
+}
+String::String(const String& other, const allocator_type& alloc)
+    : String(StringView(other), alloc) {}
+String::String(String&& other, const allocator_type& alloc)
+    : resource_(alloc.resource()) {
+  if (resource_ == other.resource_ || *resource_ == *other.resource_) {
+    Swap(other);
   } else {
-    str_ = nullptr;
+    Append(other.str_, other.size_);
   }
 }
-String::String(const String& other) : String(other.Data()){};
+String::String(String&& other) noexcept
+    : resource_(other.resource_),
+      size_(other.size_),
+      capacity_(other.capacity_) {
+  if (other.IsInline()) {
+    std::copy(other.buffer_, other.buffer_ + size_ + 1, buffer_);
+  } else {
+    str_ = other.str_;
+    other.str_ = other.buffer_;
+  }
+  other.size_ = 0;
+  other.capacity_ = kInlineCapacity;
+  other.buffer_[0] = '\0';
+}
 char& String::operator[](int index) { return str_[index]; }
 const char& String::operator[](int index) const { return str_[index]; }
 char& String::Front() { return str_[0]; }
@@ -23,77 +912,123 @@ char& String::Back() { return str_[size_ - 1]; }
 const char& String::Back() const { return str_[size_ - 1]; }
 String& String::operator=(const String& other) {
   if (&other != this) {
-    delete[] str_;
-    size_ = other.size_;
-    capacity_ = other.capacity_;
-    str_ = new char[capacity_];
+    size_ = 0;
+    Reserve(other.size_);
     std::copy(other.str_, other.str_ + other.size_, str_);
+    size_ = other.size_;
     str_[size_] = '\0';
   }
   return *this;
 }
+String& String::operator=(String&& other) {
+  if (&other != this) {
+    String newstr(std::move(other), GetAllocator());
+    Swap(newstr);
+  }
+  return *this;
+}
+void String::Release() {
+  if (!IsInline()) {
+    resource_->deallocate(str_, capacity_ + 1, alignof(char));
+  }
+}
 void String::Realloc(unsigned int new_capacity) {
-  String newstr;
-  newstr.str_ = new char[new_capacity];
-  std::copy(str_, str_ + size_, newstr.str_);
-  std::swap(str_, newstr.str_);
+  if (new_capacity <= kInlineCapacity) {
+    if (!IsInline()) {
+      std::copy(str_, str_ + size_, buffer_);
+      Release();
+      str_ = buffer_;
+    }
+    capacity_ = kInlineCapacity;
+  } else {
+    char* newstr = static_cast<char*>(
+        resource_->allocate(new_capacity + 1, alignof(char)));
+    std::copy(str_, str_ + size_, newstr);
+    Release();
+    str_ = newstr;
+    capacity_ = new_capacity;
+  }
+  str_[size_] = '\0';
+}
+void String::Grow(unsigned int required) {
+  if (capacity_ < required) {
+    Realloc(std::max(required, 2 * capacity_));
+  }
+}
+String& String::operator+=(StringView other) {
+  return Append(other.Data(), other.Size());
 }
-String& String::operator+=(const String& other) {
-  Realloc(2 * (size_ + other.size_) + 1);
-  for (unsigned int index = 0; index < other.size_; ++index) {
-    str_[index + size_] = other.str_[index];
+String& String::Append(const char* str, unsigned int length) {
+  if (size_ + length > capacity_) {
+    if (str >= str_ && str < str_ + size_) {
+      unsigned int offset = str - str_;
+      Grow(size_ + length);
+      str = str_ + offset;
+    } else {
+      Grow(size_ + length);
+    }
   }
-  size_ += other.size_;
-  capacity_ = size_ * 2;
+  memcpy(str_ + size_, str, length);
+  size_ += length;
+  str_[size_] = '\0';
+  return *this;
+}
+String& String::Append(char character, unsigned int count) {
+  Grow(size_ + count);
+  memset(str_ + size_, character, count);
+  size_ += count;
   str_[size_] = '\0';
   return *this;
 }
 String& String::operator*=(int number) {
   if (number >= 0) {
-    Realloc(2 * size_ * number + 1);
-    for (unsigned int index = size_; index < size_ * number; ++index) {
-      str_[index] = str_[index - size_];
+    Reserve(size_ * number);
+    if (number > 0) {
+      FillRepeated(str_, size_, size_ * number);
     }
     size_ *= number;
-    capacity_ = size_ * 2;
     str_[size_] = '\0';
   }
   return *this;
 }
-String String::operator+(const String& other) const {
+String String::operator+(StringView other) const& {
   String newstr;
-  newstr += *this;
-  newstr += other;
+  newstr.Reserve(size_ + other.Size());
+  newstr.Append(str_, size_);
+  newstr.Append(other.Data(), other.Size());
   return newstr;
 }
-String String::operator*(int number) const {
+String String::operator+(StringView other) && {
+  *this += other;
+  return std::move(*this);
+}
+String String::operator*(int number) const& {
   String newstr;
   if (number > 0) {
-    newstr.capacity_ = 2 * size_ * number;
-    newstr.str_ = new char[newstr.capacity_ + 1];
-    std::copy(str_, str_ + size_, newstr.str_);
-    for (unsigned int index = size_; index < size_ * number; index++) {
-      newstr.str_[index] = newstr.str_[index - size_];
-    }
+    newstr.Reserve(size_ * number);
+    memcpy(newstr.str_, str_, size_);
+    FillRepeated(newstr.str_, size_, size_ * number);
     newstr.size_ = size_ * number;
-    newstr[newstr.size_] = '\0';
+    newstr.str_[newstr.size_] = '\0';
   }
   return newstr;
 }
-String::~String() { delete[] str_; }
+String String::operator*(int number) && {
+  if (number < 0) {
+    Clear();
+  }
+  *this *= number;
+  return std::move(*this);
+}
+String::~String() { Release(); }
 const char* String::Data() const { return str_; }
 char* String::Data() { return str_; }
-void String::Clear() { size_ = 0; }
+void String::Clear() {
+  size_ = 0;
+  str_[size_] = '\0';
+}
 void String::PushBack(char character) {
-  if (size_ + 1 >= capacity_) {
-    if (size_ == 0) {
-      str_ = new char[2];
-      capacity_ = 1;
-    } else {
-      Realloc(2 * size_ + 1);
-      capacity_ = 2 * size_;
-    }
-  }
+  Grow(size_ + 1);
   str_[size_] = character;
   ++size_;
   str_[size_] = '\0';
@@ -105,79 +1040,112 @@ void String::PopBack() {
   }
 }
 void String::Resize(unsigned int length) {
-  if (size_ < length) {
-    Realloc(length + 1);
-    capacity_ = length;
+  if (capacity_ < length) {
+    Realloc(length);
   }
   size_ = length;
   str_[size_] = '\0';
 }
 void String::Resize(unsigned int length, char character) {
-  if (size_ < length) {
-    Realloc(length + 1);
-    for (unsigned int index = size_; index < length; ++index) {
-      str_[index] = character;
-    }
-    capacity_ = length;
+  if (capacity_ < length) {
+    Realloc(length);
+  }
+  for (unsigned int index = size_; index < length; ++index) {
+    str_[index] = character;
   }
   size_ = length;
   str_[size_] = '\0';
 }
 void String::Reserve(unsigned int new_cap) {
   if (capacity_ < new_cap) {
-    capacity_ = new_cap;
-    Realloc(capacity_);
+    Realloc(new_cap);
   }
 }
 void String::ShrinkToFit() {
-  capacity_ = size_;
-  Realloc(capacity_);
+  if (capacity_ > size_) {
+    Realloc(size_);
+  }
 }
 void String::Swap(String& other) {
-  std::swap(str_, other.str_);
+  char* heap = IsInline() ? nullptr : str_;
+  char* other_heap = other.IsInline() ? nullptr : other.str_;
+  std::swap(buffer_, other.buffer_);
+  str_ = other_heap != nullptr ? other_heap : buffer_;
+  other.str_ = heap != nullptr ? heap : other.buffer_;
+  std::swap(resource_, other.resource_);
   std::swap(capacity_, other.capacity_);
   std::swap(size_, other.size_);
 }
 unsigned int String::Size() const { return size_; }
 unsigned int String::Capacity() const { return capacity_; }
 bool String::Empty() const { return size_ == 0; }
-bool String::operator==(const String& other) const {
-  if (size_ != other.size_) {
-    return false;
-  }
-  for (unsigned int index = 0; index < size_; ++index) {
-    if (str_[index] != other.str_[index]) {
-      return false;
-    }
-  }
-  return true;
+size_t String::Hash() const { return StringView(*this).Hash(); }
+String& String::TrimLeft() {
+  StringView trimmed = StringView(*this).TrimLeft();
+  memmove(str_, trimmed.Data(), trimmed.Size());
+  size_ = trimmed.Size();
+  str_[size_] = '\0';
+  return *this;
 }
-bool String::operator!=(const String& other) const {
-  return !(operator==(other));
+String& String::TrimRight() {
+  size_ = StringView(*this).TrimRight().Size();
+  str_[size_] = '\0';
+  return *this;
 }
-bool String::operator>(const String& other) const {
-  for (unsigned int index = 0; index < std::min(size_, other.size_); ++index) {
-    if (str_[index] > other.str_[index]) {
-      return true;
-    }
-    if (str_[index] < other.str_[index]) {
-      return false;
-    }
+String& String::Trim() { return TrimRight().TrimLeft(); }
+String& String::ToLower() {
+  FlipCase(str_, str_, size_, 'A', 'Z');
+  return *this;
+}
+String& String::ToUpper() {
+  FlipCase(str_, str_, size_, 'a', 'z');
+  return *this;
+}
+String& String::ReplaceAll(char from, char to) {
+  ReplaceByte(str_, str_, size_, from, to);
+  return *this;
+}
+String& String::ReplaceAll(StringView from, StringView to) {
+  if (!from.Empty() && Contains(from)) {
+    String newstr(GetAllocator());
+    AppendReplaced(newstr, *this, from, to);
+    Swap(newstr);
   }
-  return size_ > other.size_;
+  return *this;
 }
-bool String::operator<(const String& other) const {
-  return other.operator>(*this);
+int String::Compare(StringView other) const {
+  return StringView(*this).Compare(other);
 }
-bool String::operator>=(const String& other) const {
-  return !(operator<(other));
+std::strong_ordering String::operator<=>(StringView other) const {
+  return StringView(*this) <=> other;
 }
-bool String::operator<=(const String& other) const {
-  return !(operator>(other));
+bool String::operator==(StringView other) const {
+  return StringView(*this) == other;
 }
-String String::Join(const std::vector<String>& strings) const {
+bool String::operator!=(StringView other) const {
+  return StringView(*this) != other;
+}
+bool String::operator>(StringView other) const {
+  return StringView(*this) > other;
+}
+bool String::operator<(StringView other) const {
+  return StringView(*this) < other;
+}
+bool String::operator>=(StringView other) const {
+  return StringView(*this) >= other;
+}
+bool String::operator<=(StringView other) const {
+  return StringView(*this) <= other;
+}
+template <typename Piece>
+String String::JoinPieces(const std::vector<Piece>& strings) const {
   String newstr;
   if (!strings.empty()) {
+    unsigned int total = size_ * (strings.size() - 1);
+    for (const Piece& str : strings) {
+      total += str.Size();
+    }
+    newstr.Reserve(total);
     for (unsigned index = 0; index < strings.size() - 1; index++) {
       newstr += strings[index];
       newstr += *this;
@@ -186,56 +1154,244 @@ String String::Join(const std::vector<String>& strings) const {
   }
   return newstr;
 }
-void String::SplitHealp(std::vector<String>& array, unsigned int& cur_index) {
-  array[cur_index].PopBack();
-  array.emplace_back();
-  cur_index += 1;
+String String::Join(const std::vector<String>& strings) const {
+  return JoinPieces(strings);
 }
-std::vector<String> String::Split(const String& delim) {
-  unsigned int delim_index = 0;
-  unsigned int cur_index = 0;
-  std::vector<String> ans;
-  ans.emplace_back();
-  for (unsigned int index = 0; index < size_; index++) {
-    ans[cur_index].PushBack(str_[index]);
-    if (delim_index == 0) {
-      if (str_[index] == delim[0]) {
-        if (delim_index == delim.size_ - 1) {
-          SplitHealp(ans, cur_index);
-        } else {
-          delim_index += 1;
-        }
-      }
-    } else if (str_[index] == delim[delim_index]) {
-      delim_index += 1;
-      if (delim_index - 1 == delim.size_ - 1) {
-        for (unsigned int i = 0; i < delim.size_ - 1; i++) {
-          ans[cur_index].PopBack();
-        }
-        SplitHealp(ans, cur_index);
-        delim_index = 0;
+String String::Join(const std::vector<StringView>& strings) const {
+  return JoinPieces(strings);
+}
+template <typename Piece>
+String String::ParallelJoinPieces(const std::vector<Piece>& strings,
+                                  unsigned int threads) const {
+  if (strings.empty()) {
+    return String();
+  }
+  std::vector<size_t> offsets(strings.size() + 1, 0);
+  for (size_t index = 0; index < strings.size(); ++index) {
+    offsets[index + 1] = offsets[index] + strings[index].Size() + size_;
+  }
+  size_t total = offsets.back() - size_;
+  unsigned int tasks = ChooseTasks(total, threads);
+  if (tasks == 1) {
+    return JoinPieces(strings);
+  }
+  String newstr;
+  newstr.Resize(total);
+  ParallelFor(tasks, [&](unsigned int task) {
+    size_t first = std::lower_bound(offsets.begin(), offsets.end() - 1,
+                                    total * task / tasks) -
+                   offsets.begin();
+    size_t last = std::lower_bound(offsets.begin(), offsets.end() - 1,
+                                   total * (task + 1) / tasks) -
+                  offsets.begin();
+    if (task + 1 == tasks) {
+      last = strings.size();
+    }
+    for (size_t index = first; index < last; ++index) {
+      char* out = newstr.str_ + offsets[index];
+      memcpy(out, strings[index].Data(), strings[index].Size());
+      if (index + 1 < strings.size()) {
+        memcpy(out + strings[index].Size(), str_, size_);
       }
-    } else {
-      delim_index = 0;
     }
+  });
+  return newstr;
+}
+String String::ParallelJoin(const std::vector<String>& strings,
+                            unsigned int threads) const {
+  return ParallelJoinPieces(strings, threads);
+}
+String String::ParallelJoin(const std::vector<StringView>& strings,
+                            unsigned int threads) const {
+  return ParallelJoinPieces(strings, threads);
+}
+std::vector<String> String::ParallelSplit(StringView delim,
+                                          unsigned int threads) const {
+  std::vector<StringView> pieces =
+      StringView(*this).ParallelSplit(delim, threads);
+  std::vector<String> ans(pieces.size());
+  unsigned int tasks = ChooseTasks(size_, threads);
+  ParallelFor(tasks, [&](unsigned int task) {
+    size_t first = pieces.size() * task / tasks;
+    size_t last = pieces.size() * (task + 1) / tasks;
+    for (size_t index = first; index < last; ++index) {
+      ans[index] = String(pieces[index]);
+    }
+  });
+  return ans;
+}
+std::vector<String> String::Split(StringView delim) const {
+  std::vector<StringView> pieces = StringView(*this).Split(delim);
+  std::vector<String> ans;
+  ans.reserve(pieces.size());
+  for (StringView piece : pieces) {
+    ans.emplace_back(piece);
   }
   return ans;
 }
+size_t String::Find(StringView needle, size_t pos) const {
+  return StringView(*this).Find(needle, pos);
+}
+size_t String::Find(char character, size_t pos) const {
+  return StringView(*this).Find(character, pos);
+}
+size_t String::RFind(StringView needle, size_t pos) const {
+  return StringView(*this).RFind(needle, pos);
+}
+size_t String::RFind(char character, size_t pos) const {
+  return StringView(*this).RFind(character, pos);
+}
+size_t String::FindFirstOf(StringView characters, size_t pos) const {
+  return StringView(*this).FindFirstOf(characters, pos);
+}
+bool String::Contains(StringView needle) const {
+  return StringView(*this).Contains(needle);
+}
+bool String::Contains(char character) const {
+  return StringView(*this).Contains(character);
+}
+size_t String::Count(StringView needle) const {
+  return StringView(*this).Count(needle);
+}
+size_t String::Count(char character) const {
+  return StringView(*this).Count(character);
+}
+std::vector<String> String::Split(char delim) const {
+  return Split(StringView(&delim, 1));
+}
+std::vector<String> String::Split(char32_t delim) const {
+  char encoded[4];
+  return Split(StringView(encoded, EncodeCodePoint(delim, encoded)));
+}
+String& String::AppendCodePoint(char32_t code_point) {
+  char encoded[4];
+  return Append(encoded, EncodeCodePoint(code_point, encoded));
+}
+bool String::IsValidUtf8() const { return StringView(*this).IsValidUtf8(); }
+size_t String::CodePointCount() const {
+  return StringView(*this).CodePointCount();
+}
+CodePointRange String::CodePoints() const { return CodePointRange(*this); }
+long long String::ParseInt() const { return StringView(*this).ParseInt(); }
+double String::ParseDouble() const { return StringView(*this).ParseDouble(); }
+String String::FromInt(long long value) {
+  String newstr;
+  newstr.AppendInt(value);
+  return newstr;
+}
+String String::FromDouble(double value) {
+  String newstr;
+  newstr.AppendDouble(value);
+  return newstr;
+}
+String& String::AppendInt(long long value) {
+  char buffer[32];
+  char* end = std::to_chars(buffer, buffer + sizeof(buffer), value).ptr;
+  return Append(buffer, end - buffer);
+}
+String& String::AppendDouble(double value) {
+  char buffer[32];
+  char* end = std::to_chars(buffer, buffer + sizeof(buffer), value).ptr;
+  return Append(buffer, end - buffer);
+}
 std::ostream& operator<<(std::ostream& out, const String& output) {
-  for (unsigned int index = 0; index < output.size_; index++) {
-    out << output.str_[index];
-  }
-  return out;
+  return out << StringView(output);
 }
 std::istream& operator>>(std::istream& in, String& to_in) {
-  char input_character;
-  while (in.get(input_character)) {
-    if (input_character == '\n' || input_character == ' ' && to_in.Size() > 0) {
-      return in;
+  std::istream::sentry sentry(in, true);
+  if (!sentry) {
+    return in;
+  }
+  std::streambuf* buffer = in.rdbuf();
+  char chunk[256];
+  unsigned int count = 0;
+  bool extracted = false;
+  for (int current = buffer->sgetc();; current = buffer->snextc()) {
+    if (current == std::istream::traits_type::eof()) {
+      in.setstate(extracted ? std::ios::eofbit
+                            : std::ios::eofbit | std::ios::failbit);
+      break;
+    }
+    char input_character = static_cast<char>(current);
+    if (input_character == '\n' ||
+        (input_character == ' ' && to_in.Size() + count > 0)) {
+      extracted = true;
+      buffer->sbumpc();
+      break;
     }
     if (input_character != ' ') {
-      to_in.PushBack(input_character);
+      extracted = true;
+      chunk[count++] = input_character;
+      if (count == sizeof(chunk)) {
+        to_in.Append(chunk, count);
+        count = 0;
+      }
     }
   }
+  to_in.Append(chunk, count);
   return in;
-}
\ No newline at end of file
+}
+StreamReader::StreamReader(std::istream& in)
+    : in_(in), buffer_(kChunkSize) {}
+bool StreamReader::Refill() {
+  std::streambuf* buffer = in_.rdbuf();
+  begin_ = 0;
+  end_ = 0;
+  if (buffer->sgetc() != std::char_traits<char>::eof()) {
+    std::streamsize available =
+        std::max<std::streamsize>(buffer->in_avail(), 1);
+    end_ = buffer->sgetn(
+        buffer_.data(),
+        std::min(available, static_cast<std::streamsize>(kChunkSize)));
+  }
+  if (end_ == 0) {
+    in_.setstate(std::ios::eofbit);
+  }
+  return end_ != 0;
+}
+bool StreamReader::ReadLine(String& line) {
+  line.Clear();
+  bool extracted = false;
+  while (begin_ != end_ || Refill()) {
+    extracted = true;
+    StringView chunk(buffer_.data() + begin_, end_ - begin_);
+    size_t found = chunk.Find('\n');
+    if (found != StringView::kNpos) {
+      line.Append(chunk.Data(), found);
+      begin_ += found + 1;
+      return true;
+    }
+    line += chunk;
+    begin_ = end_;
+  }
+  return extracted;
+}
+bool StreamReader::ReadToken(String& token) {
+  const StringView separators(" \n\t\r");
+  token.Clear();
+  while (begin_ != end_ || Refill()) {
+    StringView chunk(buffer_.data() + begin_, end_ - begin_);
+    if (token.Empty()) {
+      size_t skipped = 0;
+      while (skipped < chunk.Size() && separators.Contains(chunk[skipped])) {
+        ++skipped;
+      }
+      chunk.RemovePrefix(skipped);
+      begin_ += skipped;
+    }
+    size_t found = chunk.FindFirstOf(separators);
+    if (found != StringView::kNpos) {
+      token.Append(chunk.Data(), found);
+      begin_ += found + 1;
+      return true;
+    }
+    token += chunk;
+    begin_ = end_;
+  }
+  return !token.Empty();
+}
+HashedString::HashedString(String value)
+    : value_(std::move(value)), hash_(value_.Hash()) {}
+bool HashedString::operator==(const HashedString& other) const {
+  return hash_ == other.hash_ && value_ == other.value_;
+}
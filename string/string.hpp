@@ -1,14 +1,156 @@
 #pragma once
+#include <algorithm>
 #include <cmath>
+#include <compare>
+#include <cstdint>
 #include <cstring>
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <memory_resource>
+#include <type_traits>
 #include <vector>
+class String;
+class CodePointRange;
+class StringView {
+ public:
+  static const size_t kNpos = static_cast<size_t>(-1);
+  static const size_t kParallelChunkSize = 1 << 20;
+  StringView() = default;
+  StringView(const char* str);
+  StringView(const char* str, size_t length);
+  const char& operator[](size_t index) const;
+  const char& Front() const;
+  const char& Back() const;
+  const char* Data() const { return str_; }
+  size_t Size() const { return size_; }
+  bool Empty() const { return size_ == 0; }
+  StringView Substr(size_t pos, size_t count) const;
+  void RemovePrefix(size_t count);
+  void RemoveSuffix(size_t count);
+  std::vector<StringView> Split(StringView delim = " ") const;
+  std::vector<StringView> Split(char delim) const;
+  std::vector<StringView> Split(char32_t delim) const;
+  std::vector<StringView> ParallelSplit(StringView delim,
+                                        unsigned int threads = 0) const;
+  size_t Find(StringView needle, size_t pos = 0) const;
+  size_t Find(char character, size_t pos = 0) const;
+  size_t RFind(StringView needle, size_t pos = kNpos) const;
+  size_t RFind(char character, size_t pos = kNpos) const;
+  size_t FindFirstOf(StringView characters, size_t pos = 0) const;
+  bool Contains(StringView needle) const;
+  bool Contains(char character) const;
+  size_t Count(StringView needle) const;
+  size_t Count(char character) const;
+  size_t Hash() const;
+  StringView TrimLeft() const;
+  StringView TrimRight() const;
+  StringView Trim() const;
+  String ToLower() const;
+  String ToUpper() const;
+  String ReplaceAll(char from, char to) const;
+  String ReplaceAll(StringView from, StringView to) const;
+  bool IsValidUtf8() const;
+  size_t CodePointCount() const;
+  CodePointRange CodePoints() const;
+  long long ParseInt() const;
+  double ParseDouble() const;
+  int Compare(StringView other) const;
+  std::strong_ordering operator<=>(StringView other) const;
+  bool operator==(StringView other) const;
+  bool operator!=(StringView other) const;
+  bool operator>(StringView other) const;
+  bool operator<(StringView other) const;
+  bool operator>=(StringView other) const;
+  bool operator<=(StringView other) const;
+  friend std::ostream& operator<<(std::ostream&, StringView);
+
+ private:
+  const char* str_ = nullptr;
+  size_t size_ = 0;
+};
+class CodePointIterator {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using difference_type = std::ptrdiff_t;
+  using value_type = char32_t;
+  using pointer = const char32_t*;
+  using reference = char32_t;
+  static const char32_t kReplacement = 0xFFFD;
+  CodePointIterator() = default;
+  CodePointIterator(const char* current, const char* end);
+  char32_t operator*() const { return code_point_; }
+  CodePointIterator& operator++();
+  CodePointIterator operator++(int);
+  bool operator==(const CodePointIterator& other) const {
+    return current_ == other.current_;
+  }
+  bool operator!=(const CodePointIterator& other) const {
+    return current_ != other.current_;
+  }
+
+ private:
+  void Decode();
+  const char* current_ = nullptr;
+  const char* next_ = nullptr;
+  const char* end_ = nullptr;
+  char32_t code_point_ = 0;
+};
+class CodePointRange {
+ public:
+  explicit CodePointRange(StringView view) : view_(view) {}
+  CodePointIterator begin() const {
+    return CodePointIterator(view_.Data(), view_.Data() + view_.Size());
+  }
+  CodePointIterator end() const {
+    return CodePointIterator(view_.Data() + view_.Size(),
+                             view_.Data() + view_.Size());
+  }
+
+ private:
+  StringView view_;
+};
+class StringSearcher {
+ public:
+  static const size_t kHorspoolThreshold = 16;
+  explicit StringSearcher(StringView needle);
+  size_t Find(StringView haystack, size_t pos = 0) const;
+  size_t Count(StringView haystack) const;
+  bool Contains(StringView haystack) const;
+
+ private:
+  StringView needle_;
+  size_t shift_[256];
+};
+class StreamReader {
+ public:
+  static const size_t kChunkSize = 1 << 16;
+  explicit StreamReader(std::istream& in);
+  bool ReadLine(String& line);
+  bool ReadToken(String& token);
+
+ private:
+  bool Refill();
+  std::istream& in_;
+  std::vector<char> buffer_;
+  size_t begin_ = 0;
+  size_t end_ = 0;
+};
 class String {
  public:
+  using allocator_type = std::pmr::polymorphic_allocator<char>;
+  static const unsigned int kInlineCapacity = 15;
   String() = default;
-  String(unsigned int, char character);
-  String(const char* str);
+  explicit String(const allocator_type& alloc);
+  String(unsigned int, char character,
+         const allocator_type& alloc = allocator_type());
+  String(const char* str, const allocator_type& alloc = allocator_type());
+  explicit String(StringView view,
+                  const allocator_type& alloc = allocator_type());
   String(const String& other);
+  String(const String& other, const allocator_type& alloc);
+  String(String&& other) noexcept;
+  String(String&& other, const allocator_type& alloc);
   char& operator[](int index);
   const char& operator[](int index) const;
   char& Front();
@@ -16,13 +158,22 @@ class String {
   char& Back();
   const char& Back() const;
   String& operator=(const String& other);
-  String& operator+=(const String& other);
+  String& operator=(String&& other);
+  String& operator+=(StringView other);
   String& operator*=(int number);
-  String operator+(const String& other) const;
-  String operator*(int number) const;
+  String& Append(const char* str, unsigned int length);
+  String& Append(char character, unsigned int count);
+  template <typename Iterator>
+  String& AppendRange(Iterator first, Iterator last);
+  String operator+(StringView other) const&;
+  String operator+(StringView other) &&;
+  String operator*(int number) const&;
+  String operator*(int number) &&;
   ~String();
   const char* Data() const;
   char* Data();
+  operator StringView() const { return StringView(str_, size_); }
+  allocator_type GetAllocator() const { return allocator_type(resource_); }
   void Clear();
   void PushBack(char character);
   void PopBack();
@@ -35,20 +186,111 @@ class String {
   unsigned int Capacity() const;
   bool Empty() const;
   void Realloc(unsigned int new_capacity);
-  bool operator==(const String& other) const;
-  bool operator!=(const String& other) const;
-  bool operator>(const String& other) const;
-  bool operator<(const String& other) const;
-  bool operator>=(const String& other) const;
-  bool operator<=(const String& other) const;
+  int Compare(StringView other) const;
+  std::strong_ordering operator<=>(StringView other) const;
+  bool operator==(StringView other) const;
+  bool operator!=(StringView other) const;
+  bool operator>(StringView other) const;
+  bool operator<(StringView other) const;
+  bool operator>=(StringView other) const;
+  bool operator<=(StringView other) const;
   friend std::istream& operator>>(std::istream&, String&);
   friend std::ostream& operator<<(std::ostream&, const String&);
   String Join(const std::vector<String>& strings) const;
-  std::vector<String> Split(const String& delim = " ");
+  String Join(const std::vector<StringView>& strings) const;
+  std::vector<String> Split(StringView delim = " ") const;
+  std::vector<String> Split(char delim) const;
+  std::vector<String> Split(char32_t delim) const;
+  String ParallelJoin(const std::vector<String>& strings,
+                      unsigned int threads = 0) const;
+  String ParallelJoin(const std::vector<StringView>& strings,
+                      unsigned int threads = 0) const;
+  std::vector<String> ParallelSplit(StringView delim,
+                                    unsigned int threads = 0) const;
+  size_t Find(StringView needle, size_t pos = 0) const;
+  size_t Find(char character, size_t pos = 0) const;
+  size_t RFind(StringView needle, size_t pos = StringView::kNpos) const;
+  size_t RFind(char character, size_t pos = StringView::kNpos) const;
+  size_t FindFirstOf(StringView characters, size_t pos = 0) const;
+  bool Contains(StringView needle) const;
+  bool Contains(char character) const;
+  size_t Count(StringView needle) const;
+  size_t Count(char character) const;
+  size_t Hash() const;
+  String& TrimLeft();
+  String& TrimRight();
+  String& Trim();
+  String& ToLower();
+  String& ToUpper();
+  String& ReplaceAll(char from, char to);
+  String& ReplaceAll(StringView from, StringView to);
+  String& AppendCodePoint(char32_t code_point);
+  bool IsValidUtf8() const;
+  size_t CodePointCount() const;
+  CodePointRange CodePoints() const;
+  long long ParseInt() const;
+  double ParseDouble() const;
+  static String FromInt(long long value);
+  static String FromDouble(double value);
+  String& AppendInt(long long value);
+  String& AppendDouble(double value);
 
  private:
-  static void SplitHealp(std::vector<String>& array, unsigned int& cur_index);
-  char* str_ = nullptr;
+  template <typename Piece>
+  String JoinPieces(const std::vector<Piece>& strings) const;
+  template <typename Piece>
+  String ParallelJoinPieces(const std::vector<Piece>& strings,
+                            unsigned int threads) const;
+  bool IsInline() const { return str_ == buffer_; }
+  void Release();
+  void Grow(unsigned int required);
+  std::pmr::memory_resource* resource_ = std::pmr::get_default_resource();
+  char* str_ = buffer_;
   unsigned int size_ = 0;
-  unsigned int capacity_ = 0;
+  unsigned int capacity_ = kInlineCapacity;
+  char buffer_[kInlineCapacity + 1] = {};
+};
+template <typename Iterator>
+String& String::AppendRange(Iterator first, Iterator last) {
+  using Category = typename std::iterator_traits<Iterator>::iterator_category;
+  using Value = std::remove_cv_t<std::remove_pointer_t<Iterator>>;
+  if constexpr (std::is_pointer_v<Iterator> && std::is_same_v<Value, char>) {
+    return Append(first, last - first);
+  } else if constexpr (std::is_base_of_v<std::random_access_iterator_tag,
+                                         Category>) {
+    Grow(size_ + (last - first));
+    std::copy(first, last, str_ + size_);
+    size_ += last - first;
+    str_[size_] = '\0';
+  } else {
+    for (; first != last; ++first) {
+      PushBack(*first);
+    }
+  }
+  return *this;
+}
+class HashedString {
+ public:
+  HashedString(String value);
+  const String& Value() const { return value_; }
+  size_t Hash() const { return hash_; }
+  operator StringView() const { return value_; }
+  bool operator==(const HashedString& other) const;
+
+ private:
+  String value_;
+  size_t hash_;
+};
+template <>
+struct std::hash<StringView> {
+  size_t operator()(StringView view) const { return view.Hash(); }
+};
+template <>
+struct std::hash<String> {
+  using is_transparent = void;
+  size_t operator()(StringView view) const { return view.Hash(); }
+};
+template <>
+struct std::hash<HashedString> {
+  size_t operator()(const HashedString& str) const { return str.Hash(); }
 };
@@ -0,0 +1,92 @@
+#include "string_pool.hpp"
+namespace {
+const size_t kHeaderSize = 2 * sizeof(unsigned int);
+unsigned int ReadHeader(const char* record, size_t index) {
+  unsigned int value;
+  memcpy(&value, record + index * sizeof(unsigned int), sizeof(value));
+  return value;
+}
+}  // namespace
+unsigned int Atom::Id() const {
+  return record_ == nullptr ? kInvalidId : ReadHeader(record_, 0);
+}
+unsigned int Atom::Size() const {
+  return record_ == nullptr ? 0 : ReadHeader(record_, 1);
+}
+const char* Atom::Data() const {
+  return record_ == nullptr ? "" : record_ + kHeaderSize;
+}
+StringView Atom::View() const { return StringView(Data(), Size()); }
+Atom StringPool::Intern(StringView str) {
+  if ((atoms_.size() + 1) * 2 > slots_.size()) {
+    Rehash();
+  }
+  size_t hash = str.Hash();
+  size_t index = Probe(str, hash);
+  if (slots_[index].record == nullptr) {
+    slots_[index].hash = hash;
+    slots_[index].record = Store(str);
+    atoms_.push_back(Atom(slots_[index].record));
+  }
+  return Atom(slots_[index].record);
+}
+Atom StringPool::Find(StringView str) const {
+  if (slots_.empty()) {
+    return Atom();
+  }
+  return Atom(slots_[Probe(str, str.Hash())].record);
+}
+size_t StringPool::MemoryUsage() const {
+  return arena_size_ + slots_.size() * sizeof(Slot) +
+         atoms_.capacity() * sizeof(Atom);
+}
+size_t StringPool::Probe(StringView str, size_t hash) const {
+  size_t mask = slots_.size() - 1;
+  size_t index = hash & mask;
+  while (slots_[index].record != nullptr &&
+         (slots_[index].hash != hash || Atom(slots_[index].record) != str)) {
+    index = (index + 1) & mask;
+  }
+  return index;
+}
+const char* StringPool::Store(StringView str) {
+  const size_t align = alignof(unsigned int);
+  size_t record_size =
+      (kHeaderSize + str.Size() + 1 + align - 1) & ~(align - 1);
+  char* record;
+  if (record_size > kBlockSize / 4) {
+    std::unique_ptr<char[]> block(new char[record_size]);
+    record = block.get();
+    blocks_.insert(blocks_.empty() ? blocks_.end() : blocks_.end() - 1,
+                   std::move(block));
+    arena_size_ += record_size;
+  } else {
+    if (block_used_ + record_size > kBlockSize) {
+      blocks_.emplace_back(new char[kBlockSize]);
+      block_used_ = 0;
+      arena_size_ += kBlockSize;
+    }
+    record = blocks_.back().get() + block_used_;
+    block_used_ += record_size;
+  }
+  unsigned int header[2] = {static_cast<unsigned int>(atoms_.size()),
+                            static_cast<unsigned int>(str.Size())};
+  memcpy(record, header, kHeaderSize);
+  memcpy(record + kHeaderSize, str.Data(), str.Size());
+  record[kHeaderSize + str.Size()] = '\0';
+  return record;
+}
+void StringPool::Rehash() {
+  std::vector<Slot> old_slots(std::max<size_t>(16, slots_.size() * 2));
+  old_slots.swap(slots_);
+  size_t mask = slots_.size() - 1;
+  for (const Slot& slot : old_slots) {
+    if (slot.record != nullptr) {
+      size_t index = slot.hash & mask;
+      while (slots_[index].record != nullptr) {
+        index = (index + 1) & mask;
+      }
+      slots_[index] = slot;
+    }
+  }
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <memory>
+#include <vector>
+
+#include "string.hpp"
+class Atom {
+ public:
+  static const unsigned int kInvalidId = static_cast<unsigned int>(-1);
+  Atom() = default;
+  unsigned int Id() const;
+  unsigned int Size() const;
+  const char* Data() const;
+  StringView View() const;
+  operator StringView() const { return View(); }
+  bool operator==(Atom other) const { return record_ == other.record_; }
+  bool operator!=(Atom other) const { return record_ != other.record_; }
+
+ private:
+  friend class StringPool;
+  explicit Atom(const char* record) : record_(record) {}
+  const char* record_ = nullptr;
+};
+class StringPool {
+ public:
+  static const size_t kBlockSize = 1 << 16;
+  StringPool() = default;
+  StringPool(const StringPool& other) = delete;
+  StringPool& operator=(const StringPool& other) = delete;
+  StringPool(StringPool&& other) = default;
+  StringPool& operator=(StringPool&& other) = default;
+  Atom Intern(StringView str);
+  Atom Find(StringView str) const;
+  Atom operator[](unsigned int id) const { return atoms_[id]; }
+  size_t Size() const { return atoms_.size(); }
+  size_t MemoryUsage() const;
+
+ private:
+  struct Slot {
+    size_t hash = 0;
+    const char* record = nullptr;
+  };
+  size_t Probe(StringView str, size_t hash) const;
+  const char* Store(StringView str);
+  void Rehash();
+  std::vector<std::unique_ptr<char[]>> blocks_;
+  size_t block_used_ = kBlockSize;
+  size_t arena_size_ = 0;
+  std::vector<Slot> slots_;
+  std::vector<Atom> atoms_;
+};
+template <>
+struct std::hash<Atom> {
+  size_t operator()(Atom atom) const {
+    return std::hash<unsigned int>()(atom.Id());
+  }
+};
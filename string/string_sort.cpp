@@ -0,0 +1,173 @@
+#include "string_sort.hpp"
+
+#include <atomic>
+#include <thread>
+namespace {
+const size_t kInsertionThreshold = 32;
+const size_t kParallelThreshold = 1 << 16;
+const size_t kBuckets = 257;
+struct Key {
+  const char* data = nullptr;
+  size_t size = 0;
+  size_t index = 0;
+};
+bool Less(const Key& lhs, const Key& rhs, size_t depth) {
+  size_t common = std::min(lhs.size, rhs.size) - depth;
+  int cmp =
+      common == 0 ? 0 : memcmp(lhs.data + depth, rhs.data + depth, common);
+  return cmp < 0 || (cmp == 0 && lhs.size < rhs.size);
+}
+void InsertionSort(Key* first, Key* last, size_t depth) {
+  for (Key* current = first + 1; current < last; ++current) {
+    Key key = *current;
+    Key* hole = current;
+    for (; hole != first && Less(key, *(hole - 1), depth); --hole) {
+      *hole = *(hole - 1);
+    }
+    *hole = key;
+  }
+}
+bool Partition(Key* first, Key* last, Key* buffer, uint16_t* digits,
+               size_t& depth, size_t* bounds) {
+  size_t size = last - first;
+  while (true) {
+    size_t counts[kBuckets] = {};
+    for (size_t index = 0; index < size; ++index) {
+      digits[index] =
+          first[index].size > depth
+              ? static_cast<unsigned char>(first[index].data[depth]) + 1
+              : 0;
+      ++counts[digits[index]];
+    }
+    if (counts[digits[0]] == size) {
+      if (digits[0] == 0) {
+        return false;
+      }
+      ++depth;
+      continue;
+    }
+    bounds[0] = 0;
+    for (size_t bucket = 0; bucket < kBuckets; ++bucket) {
+      bounds[bucket + 1] = bounds[bucket] + counts[bucket];
+    }
+    size_t positions[kBuckets];
+    std::copy(bounds, bounds + kBuckets, positions);
+    for (size_t index = 0; index < size; ++index) {
+      buffer[positions[digits[index]]++] = first[index];
+    }
+    std::copy(buffer, buffer + size, first);
+    return true;
+  }
+}
+void SortKeys(Key* first, Key* last, Key* buffer, uint16_t* digits,
+              size_t depth) {
+  while (true) {
+    if (static_cast<size_t>(last - first) <= kInsertionThreshold) {
+      InsertionSort(first, last, depth);
+      return;
+    }
+    size_t bounds[kBuckets + 1];
+    if (!Partition(first, last, buffer, digits, depth, bounds)) {
+      return;
+    }
+    size_t largest = 1;
+    for (size_t bucket = 2; bucket < kBuckets; ++bucket) {
+      if (bounds[bucket + 1] - bounds[bucket] >
+          bounds[largest + 1] - bounds[largest]) {
+        largest = bucket;
+      }
+    }
+    for (size_t bucket = 1; bucket < kBuckets; ++bucket) {
+      if (bucket != largest && bounds[bucket + 1] - bounds[bucket] > 1) {
+        SortKeys(first + bounds[bucket], first + bounds[bucket + 1],
+                 buffer + bounds[bucket], digits + bounds[bucket], depth + 1);
+      }
+    }
+    last = first + bounds[largest + 1];
+    first += bounds[largest];
+    buffer += bounds[largest];
+    digits += bounds[largest];
+    ++depth;
+  }
+}
+void ParallelSortKeys(std::vector<Key>& keys, unsigned int threads) {
+  std::vector<Key> buffer(keys.size());
+  std::vector<uint16_t> digits(keys.size());
+  if (threads == 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  if (threads == 1 || keys.size() < kParallelThreshold) {
+    SortKeys(keys.data(), keys.data() + keys.size(), buffer.data(),
+             digits.data(), 0);
+    return;
+  }
+  size_t depth = 0;
+  size_t bounds[kBuckets + 1];
+  if (!Partition(keys.data(), keys.data() + keys.size(), buffer.data(),
+                 digits.data(), depth, bounds)) {
+    return;
+  }
+  std::vector<size_t> order;
+  for (size_t bucket = 1; bucket < kBuckets; ++bucket) {
+    if (bounds[bucket + 1] - bounds[bucket] > 1) {
+      order.push_back(bucket);
+    }
+  }
+  std::sort(order.begin(), order.end(), [&bounds](size_t lhs, size_t rhs) {
+    return bounds[lhs + 1] - bounds[lhs] > bounds[rhs + 1] - bounds[rhs];
+  });
+  std::atomic<size_t> next{0};
+  auto work = [&]() {
+    for (size_t task = next++; task < order.size(); task = next++) {
+      size_t begin = bounds[order[task]];
+      size_t end = bounds[order[task] + 1];
+      SortKeys(keys.data() + begin, keys.data() + end, buffer.data() + begin,
+               digits.data() + begin, depth + 1);
+    }
+  };
+  std::vector<std::thread> workers;
+  threads = std::min<size_t>(threads, order.size());
+  for (unsigned int worker = 1; worker < threads; ++worker) {
+    workers.emplace_back(work);
+  }
+  work();
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+}
+template <typename Piece>
+std::vector<Key> MakeKeys(const std::vector<Piece>& strings) {
+  std::vector<Key> keys(strings.size());
+  for (size_t index = 0; index < strings.size(); ++index) {
+    keys[index] = Key{strings[index].Data(), strings[index].Size(), index};
+  }
+  return keys;
+}
+void Apply(const std::vector<Key>& keys, std::vector<StringView>& strings) {
+  for (size_t index = 0; index < keys.size(); ++index) {
+    strings[index] = StringView(keys[index].data, keys[index].size);
+  }
+}
+void Apply(const std::vector<Key>& keys, std::vector<String>& strings) {
+  std::vector<String> sorted;
+  sorted.reserve(strings.size());
+  for (const Key& key : keys) {
+    sorted.push_back(std::move(strings[key.index]));
+  }
+  strings.swap(sorted);
+}
+}  // namespace
+void RadixSort(std::vector<StringView>& strings) {
+  ParallelRadixSort(strings, 1);
+}
+void RadixSort(std::vector<String>& strings) { ParallelRadixSort(strings, 1); }
+void ParallelRadixSort(std::vector<StringView>& strings, unsigned int threads) {
+  std::vector<Key> keys = MakeKeys(strings);
+  ParallelSortKeys(keys, threads);
+  Apply(keys, strings);
+}
+void ParallelRadixSort(std::vector<String>& strings, unsigned int threads) {
+  std::vector<Key> keys = MakeKeys(strings);
+  ParallelSortKeys(keys, threads);
+  Apply(keys, strings);
+}
@@ -0,0 +1,9 @@
+#pragma once
+#include <vector>
+
+#include "string.hpp"
+void RadixSort(std::vector<StringView>& strings);
+void RadixSort(std::vector<String>& strings);
+void ParallelRadixSort(std::vector<StringView>& strings,
+                       unsigned int threads = 0);
+void ParallelRadixSort(std::vector<String>& strings, unsigned int threads = 0);